@@ -91,15 +91,11 @@ void herbsearch(region * r, unit * u, int max)
 
 static int begin_potion(unit * u, const potion_type * ptype, struct order *ord)
 {
-  static int rule_multipotion = -1;
+  /* should we allow multiple different potions to be used the same turn? */
+  static rule_int rule_multipotion = RULE_INT("rules.magic.multipotion", 0);
   assert(ptype != NULL);
 
-  if (rule_multipotion < 0) {
-    /* should we allow multiple different potions to be used the same turn? */
-    rule_multipotion =
-      get_param_int(global.parameters, "rules.magic.multipotion", 0);
-  }
-  if (!rule_multipotion) {
+  if (!rule_get_int(&rule_multipotion)) {
     const potion_type *use = ugetpotionuse(u);
     if (use != NULL && use != ptype) {
       ADDMSG(&u->faction->msgs,
@@ -125,13 +121,10 @@ static int do_potion(unit * u, region *r, const potion_type * ptype, int amount)
 {
   if (ptype == oldpotiontype[P_LIFE]) {
     int holz = 0;
-    static int tree_type = -1;
-    static int tree_count = -1;
-    if (tree_type < 0) {
-      tree_type = get_param_int(global.parameters, "rules.magic.wol_type", 1);
-      tree_count =
-        get_param_int(global.parameters, "rules.magic.wol_effect", 10);
-    }
+    static rule_int rule_type = RULE_INT("rules.magic.wol_type", 1);
+    static rule_int rule_count = RULE_INT("rules.magic.wol_effect", 10);
+    int tree_type = rule_get_int(&rule_type);
+    int tree_count = rule_get_int(&rule_count);
     /* mallorn is required to make mallorn forests, wood for regular ones */
     if (fval(r, RF_MALLORN)) {
       holz = use_pooled(u, rt_find("mallorn"),
@@ -89,7 +89,6 @@ static FILE *bdebug;
 #endif
 
 #undef DEBUG_FAST               /* should be disabled when b->fast and b->rowcache works */
-#define DEBUG_SELECT            /* should be disabled if select_enemy works */
 
 typedef enum combatmagic {
     DO_PRECOMBATSPELL,
@@ -695,24 +694,17 @@ weapon_skill(const weapon_type * wtype, const unit * u, bool attacking)
 
 static int CavalrySkill(void)
 {
-    static int skill = -1;
-
-    if (skill < 0) {
-        skill = get_param_int(global.parameters, "rules.cavalry.skill", 2);
-    }
-    return skill;
+    static rule_int rule = RULE_INT("rules.cavalry.skill", 2);
+    return rule_get_int(&rule);
 }
 
 #define BONUS_SKILL 1
 #define BONUS_DAMAGE 2
 static int CavalryBonus(const unit * u, troop enemy, int type)
 {
-    static int mode = -1;
+    static rule_int rule_mode = RULE_INT("rules.cavalry.mode", 1);
 
-    if (mode < 0) {
-        mode = get_param_int(global.parameters, "rules.cavalry.mode", 1);
-    }
-    if (mode == 0) {
+    if (rule_get_int(&rule_mode) == 0) {
         /* old rule, Eressea 1.0 compat */
         return (type == BONUS_SKILL) ? 2 : 0;
     }
@@ -950,6 +942,7 @@ void remove_troop(troop dt)
     battle *b = df->side->battle;
     b->fast.alive = -1;           /* invalidate cached value */
     b->rowcache.alive = -1;       /* invalidate cached value */
+    b->selectcache.alive = -1;    /* invalidate cached value */
     ++df->removed;
     ++df->side->removed;
     df->person[dt.index] = df->person[df->alive - df->removed];
@@ -1033,9 +1026,8 @@ const char *rel_dam(int dam, int hp)
 
 static void vampirism(troop at, int damage)
 {
-    static int vampire = -1;
-    if (vampire < 0)
-        vampire = get_param_int(global.parameters, "rules.combat.demon_vampire", 0);
+    static rule_int rule_vampire = RULE_INT("rules.combat.demon_vampire", 0);
+    int vampire = rule_get_int(&rule_vampire);
     if (vampire > 0) {
         int gain = damage / vampire;
         int chance = damage - vampire * gain;
@@ -1080,7 +1072,7 @@ terminate(troop dt, troop at, int type, const char *damage, bool missile)
     unit *du = df->unit;
     battle *b = df->side->battle;
     int heiltrank = 0;
-    static int rule_armor = -1;
+    static rule_int rule_armor = RULE_INT("rules.combat.nat_armor", 0);
 
     /* Schild */
     side *ds = df->side;
@@ -1158,10 +1150,7 @@ terminate(troop dt, troop at, int type, const char *damage, bool missile)
     }
 #endif
 
-    if (rule_armor < 0) {
-        rule_armor = get_param_int(global.parameters, "rules.combat.nat_armor", 0);
-    }
-    if (rule_armor == 0) {
+    if (rule_get_int(&rule_armor) == 0) {
         /* natrliche Rstung ist halbkumulativ */
         if (ar > 0) {
             ar += an / 2;
@@ -1481,30 +1470,15 @@ int select)
     return 0;
 }
 
-troop select_enemy(fighter * af, int minrow, int maxrow, int select)
+/* collects the enemies of af that are in range, in the order in which
+ * select_enemy numbers them, with the running total of their troops. */
+static void
+fill_selectcache(battle * b, fighter * af, int minrow, int maxrow, int select)
 {
     side *as = af->side;
-    battle *b = as->battle;
-    int si, selected;
-    int enemies;
-#ifdef DEBUG_SELECT
-    troop result = no_troop;
-#endif
-    if (u_race(af->unit)->flags & RCF_FLY) {
-        /* flying races ignore min- and maxrow and can attack anyone fighting
-         * them */
-        minrow = FIGHT_ROW;
-        maxrow = BEHIND_ROW;
-    }
-    minrow = _max(minrow, FIGHT_ROW);
+    int si, total = 0;
 
-    enemies = count_enemies(b, af, minrow, maxrow, select);
-
-    /* Niemand ist in der angegebenen Entfernung? */
-    if (enemies <= 0)
-        return no_troop;
-
-    selected = rng_int() % enemies;
+    b->selectcache.size = 0;
     for (si = 0; as->enemies[si]; ++si) {
         side *ds = as->enemies[si];
         fighter *df;
@@ -1523,6 +1497,8 @@ troop select_enemy(fighter * af, int minrow, int maxrow, int select)
         for (df = ds->fighters; df; df = df->next) {
             int dr;
 
+            if (df->alive - df->removed <= 0)
+                continue;
             dr = statusrow(df->status);
             if (select & SELECT_ADVANCE) {
                 if (unitrow[dr] < 0) {
@@ -1535,32 +1511,78 @@ troop select_enemy(fighter * af, int minrow, int maxrow, int select)
                 dr += offset;
             if (dr < minrow || dr > maxrow)
                 continue;
-            if (df->alive - df->removed > selected) {
-#ifdef DEBUG_SELECT
-                if (result.fighter == NULL) {
-                    result.index = selected;
-                    result.fighter = df;
-                }
-#else
-                troop dt;
-                dt.index = selected;
-                dt.fighter = df;
-                return dt;
-#endif
+            if (b->selectcache.size == b->selectcache.maxsize) {
+                int maxsize = b->selectcache.maxsize ? b->selectcache.maxsize * 2 : 32;
+                b->selectcache.fighters = (fighter **)realloc(b->selectcache.fighters, maxsize * sizeof(fighter *));
+                b->selectcache.troops = (int *)realloc(b->selectcache.troops, maxsize * sizeof(int));
+                b->selectcache.maxsize = maxsize;
             }
-            selected -= (df->alive - df->removed);
-            enemies -= (df->alive - df->removed);
-        }
+            total += df->alive - df->removed;
+            b->selectcache.fighters[b->selectcache.size] = df;
+            b->selectcache.troops[b->selectcache.size] = total;
+            ++b->selectcache.size;
+        }
+    }
+    b->selectcache.as = as;
+    b->selectcache.status = statusrow(af->status);
+    b->selectcache.minrow = minrow;
+    b->selectcache.maxrow = maxrow;
+    b->selectcache.select = select;
+    b->selectcache.alive = b->alive;
+}
+
+troop select_enemy(fighter * af, int minrow, int maxrow, int select)
+{
+    side *as = af->side;
+    battle *b = as->battle;
+    int selected, lo, hi;
+    int enemies, total;
+    troop dt;
+
+    if (u_race(af->unit)->flags & RCF_FLY) {
+        /* flying races ignore min- and maxrow and can attack anyone fighting
+         * them */
+        minrow = FIGHT_ROW;
+        maxrow = BEHIND_ROW;
     }
-    if (enemies != 0) {
+    minrow = _max(minrow, FIGHT_ROW);
+
+    enemies = count_enemies(b, af, minrow, maxrow, select);
+
+    /* Niemand ist in der angegebenen Entfernung? */
+    if (enemies <= 0)
+        return no_troop;
+
+    if (b->alive != b->selectcache.alive || as != b->selectcache.as
+        || statusrow(af->status) != b->selectcache.status
+        || minrow != b->selectcache.minrow || maxrow != b->selectcache.maxrow
+        || select != b->selectcache.select) {
+        fill_selectcache(b, af, minrow, maxrow, select);
+    }
+    total = b->selectcache.size ? b->selectcache.troops[b->selectcache.size - 1] : 0;
+    if (total != enemies) {
         log_error("select_enemies has a bug.\n");
     }
-#ifdef DEBUG_SELECT
-    return result;
-#else
-    assert(!selected);
-    return no_troop;
-#endif
+
+    /* find the first fighter whose running total exceeds the selection */
+    selected = rng_int() % enemies;
+    if (selected >= total)
+        return no_troop;
+    lo = 0;
+    hi = b->selectcache.size - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (b->selectcache.troops[mid] > selected) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    dt.fighter = b->selectcache.fighters[lo];
+    dt.index = selected - (lo ? b->selectcache.troops[lo - 1] : 0);
+    assert(dt.index < dt.fighter->alive - dt.fighter->removed);
+    return dt;
 }
 
 static int get_tactics(const side * as, const side * ds)
@@ -1889,10 +1911,8 @@ int skilldiff(troop at, troop dt, int dist)
     }
 
     if (u_race(au) == get_race(RC_GOBLIN)) {
-        static int goblin_bonus = -1;
-        if (goblin_bonus < 0)
-            goblin_bonus =
-            get_param_int(global.parameters, "rules.combat.goblinbonus", 10);
+        static rule_int rule_goblin = RULE_INT("rules.combat.goblinbonus", 10);
+        int goblin_bonus = rule_get_int(&rule_goblin);
         if (af->side->size[SUM_ROW] >= df->side->size[SUM_ROW] * goblin_bonus) {
             skdiff += 1;
         }
@@ -2093,10 +2113,8 @@ static int attacks_per_round(troop t)
 static void make_heroes(battle * b)
 {
     side *s;
-    static int hero_speed = 0;
-    if (hero_speed == 0) {
-        hero_speed = get_param_int(global.parameters, "rules.combat.herospeed", 10);
-    }
+    static rule_int rule_speed = RULE_INT("rules.combat.herospeed", 10);
+    int hero_speed = rule_get_int(&rule_speed);
     for (s = b->sides; s != b->sides + b->nsides; ++s) {
         fighter *fig;
         for (fig = s->fighters; fig; fig = fig->next) {
@@ -2495,12 +2513,10 @@ troop select_ally(fighter * af, int minrow, int maxrow, int allytype)
 static int loot_quota(const unit * src, const unit * dst,
     const item_type * type, int n)
 {
-    static float divisor = -1;
+    static rule_flt rule_divisor = RULE_FLT("rules.items.loot_divisor", 1);
     if (dst && src && src->faction != dst->faction) {
-        if (divisor < 0) {
-            divisor = get_param_flt(global.parameters, "rules.items.loot_divisor", 1);
-            assert(divisor == 0 || divisor >= 1);
-        }
+        float divisor = rule_get_flt(&rule_divisor);
+        assert(divisor == 0 || divisor >= 1);
         if (divisor >= 1) {
             double r = n / divisor;
             int x = (int)r;
@@ -2612,14 +2628,9 @@ static bool seematrix(const faction * f, const side * s)
 
 static double PopulationDamage(void)
 {
-    static double value = -1.0;
-    if (value < 0) {
-        int damage =
-            get_param_int(global.parameters, "rules.combat.populationdamage",
-            BATTLE_KILLS_PEASANTS);
-        value = damage / 100.0;
-    }
-    return value;
+    static rule_int rule = RULE_INT("rules.combat.populationdamage",
+        BATTLE_KILLS_PEASANTS);
+    return rule_get_int(&rule) / 100.0;
 }
 
 static void battle_effects(battle * b, int dead_players)
@@ -3195,11 +3206,9 @@ side * get_side(battle * b, const struct unit * u)
 side * find_side(battle * b, const faction * f, const group * g, int flags, const faction * stealthfaction)
 {
     side * s;
-    static int rule_anon_battle = -1;
+    static rule_int rule_anon = RULE_INT("rules.stealth.anon_battle", 1);
+    int rule_anon_battle = rule_get_int(&rule_anon);
 
-    if (rule_anon_battle < 0) {
-        rule_anon_battle = get_param_int(global.parameters, "rules.stealth.anon_battle", 1);
-    }
     for (s = b->sides; s != b->sides + b->nsides; ++s) {
         if (s->faction == f && s->group == g) {
             int s1flags = flags | SIDE_HASGUARDS;
@@ -4338,5 +4347,7 @@ void battle_free(battle * b) {
         }
         free_side(s);
     }
+    free(b->selectcache.fighters);
+    free(b->selectcache.troops);
 }
 
@@ -112,6 +112,16 @@ extern "C" {
       int minrow, maxrow;
       int enemies[8];
     } fast;
+    struct {
+      const struct side *as;
+      int alive;
+      int status;
+      int minrow, maxrow;
+      int select;
+      int size, maxsize;
+      struct fighter **fighters;  /* enemies in range, in selection order */
+      int *troops;                /* running total of troops in fighters */
+    } selectcache;
   } battle;
 
   typedef struct weapon {
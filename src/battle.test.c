@@ -169,6 +169,57 @@ static void test_building_bonus_respects_size(CuTest * tc)
   CuAssertPtrEquals(tc, 0, df->building);
 }
 
+static void test_select_enemy(CuTest * tc)
+{
+  unit *du1, *du2, *au;
+  region *r;
+  fighter *df1, *df2, *af;
+  battle *b;
+  side *ds, *as;
+  troop dt;
+  int i, hits[2] = { 0, 0 };
+
+  test_cleanup();
+  test_create_world();
+  r = findregion(0, 0);
+  du1 = test_create_unit(test_create_faction(rc_find("human")), r);
+  du2 = test_create_unit(du1->faction, r);
+  au = test_create_unit(test_create_faction(rc_find("human")), r);
+  scale_number(du1, 2);
+  scale_number(du2, 3);
+
+  b = make_battle(r);
+  ds = make_side(b, du1->faction, 0, 0, 0);
+  df1 = make_fighter(b, du1, ds, false);
+  df2 = make_fighter(b, du2, ds, false);
+  as = make_side(b, au->faction, 0, 0, 0);
+  af = make_fighter(b, au, as, true);
+  as->relations[ds->index] |= E_ENEMY;
+  ds->relations[as->index] |= E_ENEMY;
+  as->enemies[0] = ds;
+  ds->enemies[0] = as;
+
+  for (i = 0; i != 100; ++i) {
+    dt = select_enemy(af, FIGHT_ROW, BEHIND_ROW, 0);
+    CuAssertTrue(tc, dt.fighter == df1 || dt.fighter == df2);
+    CuAssertTrue(tc, dt.index >= 0 && dt.index < dt.fighter->alive);
+    ++hits[dt.fighter == df2];
+  }
+  CuAssertTrue(tc, hits[0] > 0 && hits[1] > 0);
+
+  dt.fighter = df2;
+  for (dt.index = 2; dt.index >= 0; --dt.index) {
+    remove_troop(dt);
+  }
+  for (i = 0; i != 20; ++i) {
+    dt = select_enemy(af, FIGHT_ROW, BEHIND_ROW, 0);
+    CuAssertPtrEquals(tc, df1, dt.fighter);
+    CuAssertTrue(tc, dt.index >= 0 && dt.index < 2);
+  }
+  battle_free(b);
+  test_cleanup();
+}
+
 CuSuite *get_battle_suite(void)
 {
   CuSuite *suite = CuSuiteNew();
@@ -176,5 +227,6 @@ CuSuite *get_battle_suite(void)
   SUITE_ADD_TEST(suite, test_defenders_get_building_bonus);
   SUITE_ADD_TEST(suite, test_attackers_get_no_building_bonus);
   SUITE_ADD_TEST(suite, test_building_bonus_respects_size);
+  SUITE_ADD_TEST(suite, test_select_enemy);
   return suite;
 }
@@ -21,6 +21,18 @@ int eressea_read_game(const char * filename) {
   return readgame(filename, false);
 } 
 
+int eressea_open_game(const char * filename) {
+  return opengame(filename);
+}
+
+int eressea_load_region(int x, int y) {
+  return readgame_region(x, y) ? 0 : -1;
+}
+
+void eressea_close_game(void) {
+  closegame();
+}
+
 int eressea_write_game(const char * filename) {
   remove_empty_factions();
   return writegame(filename);
@@ -6,6 +6,9 @@ extern "C" {
 
 void eressea_free_game(void);
 int eressea_read_game(const char * filename);
+int eressea_open_game(const char * filename);
+int eressea_load_region(int x, int y);
+void eressea_close_game(void);
 int eressea_write_game(const char * filename);
 int eressea_read_orders(const char * filename);
 
@@ -479,9 +479,14 @@ static int tolua_write_report(lua_State * L)
 
 static int tolua_write_reports(lua_State * L)
 {
+  int part = (int)tolua_tonumber(L, 1, 0);
+  int parts = (int)tolua_tonumber(L, 2, 1);
   int result;
+  if (parts < 1 || part < 0 || part >= parts) {
+    return luaL_error(L, "write_reports: invalid part %d of %d", part, parts);
+  }
   init_reports();
-  result = reports();
+  result = reports_partition(part, parts);
   tolua_pushnumber(L, (lua_Number) result);
   return 1;
 }
@@ -1131,7 +1131,7 @@ static char *cr_output_resource(char *buf, const char *name,
 }
 
 static void
-cr_borders(seen_region ** seen, const region * r, const faction * f,
+cr_borders(struct seen_data *seen, const region * r, const faction * f,
 int seemode, FILE * F)
 {
     direction_t d;
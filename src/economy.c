@@ -3047,20 +3047,15 @@ void entertain_cmd(unit * u, struct order *ord)
     region *r = u->region;
     int max_e;
     request *o;
-    static int entertainbase = 0;
-    static int entertainperlevel = 0;
+    static rule_int rule_base = RULE_INT("entertain.base", 0);
+    static rule_int rule_perlevel = RULE_INT("entertain.perlevel", 0);
+    int entertainbase, entertainperlevel;
     keyword_t kwd;
 
     kwd = init_order(ord);
     assert(kwd == K_ENTERTAIN);
-    if (!entertainbase) {
-        const char *str = get_param(global.parameters, "entertain.base");
-        entertainbase = str ? atoi(str) : 0;
-    }
-    if (!entertainperlevel) {
-        const char *str = get_param(global.parameters, "entertain.perlevel");
-        entertainperlevel = str ? atoi(str) : 0;
-    }
+    entertainbase = rule_get_int(&rule_base);
+    entertainperlevel = rule_get_int(&rule_perlevel);
     if (fval(u, UFL_WERE)) {
         cmistake(u, ord, 58, MSG_INCOME);
         return;
@@ -3345,7 +3340,8 @@ void produce(struct region *r)
     request *taxorders, *sellorders, *stealorders, *buyorders;
     unit *u;
     int todo;
-    static int rule_autowork = -1;
+    static rule_int rule_autowork = RULE_INT("work.auto", 0);
+    bool autowork;
     bool limited = true;
     request *nextworker = workers;
     assert(r);
@@ -3360,9 +3356,7 @@ void produce(struct region *r)
      *
      * lehren vor lernen. */
 
-    if (rule_autowork < 0) {
-        rule_autowork = get_param_int(global.parameters, "work.auto", 0);
-    }
+    autowork = rule_get_int(&rule_autowork) != 0;
 
     assert(rmoney(r) >= 0);
     assert(rpeasants(r) >= 0);
@@ -3436,7 +3430,7 @@ void produce(struct region *r)
             break;
 
         case K_WORK:
-            if (!rule_autowork && do_work(u, u->thisorder, nextworker) == 0) {
+            if (!autowork && do_work(u, u->thisorder, nextworker) == 0) {
                 assert(nextworker - workers < MAX_WORKERS);
                 ++nextworker;
             }
@@ -3475,7 +3469,7 @@ void produce(struct region *r)
      * auszugeben bereit sind. */
     if (entertaining)
         expandentertainment(r);
-    if (!rule_autowork) {
+    if (!autowork) {
         expandwork(r, workers, nextworker, maxworkingpeasants(r));
     }
     if (taxorders)
@@ -79,6 +79,86 @@ static int tolua_eressea_eressea_read_game00(lua_State* tolua_S)
 #endif
 }
 
+/* function: eressea_open_game */
+static int tolua_eressea_eressea_open_game00(lua_State* tolua_S)
+{
+#ifndef TOLUA_RELEASE
+ tolua_Error tolua_err;
+ if (
+ !tolua_isstring(tolua_S,1,0,&tolua_err) || 
+ !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+ goto tolua_lerror;
+ else
+#endif
+ {
+  const char* filename = ((const char*)  tolua_tostring(tolua_S,1,0));
+ {
+  int tolua_ret = (int)  eressea_open_game(filename);
+ tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
+ }
+ }
+ return 1;
+#ifndef TOLUA_RELEASE
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'open_game'.",&tolua_err);
+ return 0;
+#endif
+}
+
+/* function: eressea_load_region */
+static int tolua_eressea_eressea_load_region00(lua_State* tolua_S)
+{
+#ifndef TOLUA_RELEASE
+ tolua_Error tolua_err;
+ if (
+ !tolua_isnumber(tolua_S,1,0,&tolua_err) || 
+ !tolua_isnumber(tolua_S,2,0,&tolua_err) || 
+ !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+ goto tolua_lerror;
+ else
+#endif
+ {
+  int x = ((int)  tolua_tonumber(tolua_S,1,0));
+  int y = ((int)  tolua_tonumber(tolua_S,2,0));
+ {
+  int tolua_ret = (int)  eressea_load_region(x,y);
+ tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
+ }
+ }
+ return 1;
+#ifndef TOLUA_RELEASE
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'load_region'.",&tolua_err);
+ return 0;
+#endif
+}
+
+/* function: eressea_close_game */
+static int tolua_eressea_eressea_close_game00(lua_State* tolua_S)
+{
+#ifndef TOLUA_RELEASE
+ tolua_Error tolua_err;
+ if (
+ !tolua_isnoobj(tolua_S,1,&tolua_err)
+ )
+ goto tolua_lerror;
+ else
+#endif
+ {
+ {
+  eressea_close_game();
+ }
+ }
+ return 0;
+#ifndef TOLUA_RELEASE
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'close_game'.",&tolua_err);
+ return 0;
+#endif
+}
+
 /* function: eressea_write_game */
 static int tolua_eressea_eressea_write_game00(lua_State* tolua_S)
 {
@@ -200,6 +280,9 @@ LUALIB_API int luaopen_eressea (lua_State* tolua_S)
  tolua_beginmodule(tolua_S,"eressea");
  tolua_function(tolua_S,"free_game",tolua_eressea_eressea_free_game00);
  tolua_function(tolua_S,"read_game",tolua_eressea_eressea_read_game00);
+ tolua_function(tolua_S,"open_game",tolua_eressea_eressea_open_game00);
+ tolua_function(tolua_S,"load_region",tolua_eressea_eressea_load_region00);
+ tolua_function(tolua_S,"close_game",tolua_eressea_eressea_close_game00);
  tolua_function(tolua_S,"write_game",tolua_eressea_eressea_write_game00);
  tolua_function(tolua_S,"read_orders",tolua_eressea_eressea_read_orders00);
  tolua_function(tolua_S,"export",tolua_eressea_eressea_export00);
@@ -52,12 +52,8 @@
 
 static int GiveRestriction(void)
 {
-    static int value = -1;
-    if (value < 0) {
-        const char *str = get_param(global.parameters, "GiveRestriction");
-        value = str ? atoi(str) : 0;
-    }
-    return value;
+    static rule_int rule = RULE_INT("GiveRestriction", 0);
+    return rule_get_int(&rule);
 }
 
 static void
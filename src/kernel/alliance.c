@@ -347,6 +347,7 @@ void setalliance(faction * f, alliance * al)
 {
   if (f->alliance == al)
     return;
+  allies_changed();
   if (f->alliance != NULL) {
     int qi;
     quicklist **flistp = &f->alliance->members;
@@ -1,4 +1,5 @@
-#include "types.h"
+#include <platform.h>
+#include <kernel/config.h>
 #include "ally.h"
 
 #include <stdlib.h>
@@ -12,6 +13,7 @@ ally * ally_find(ally *al, const struct faction *f) {
 
 ally * ally_add(ally **al_p, struct faction *f) {
   ally * al;
+  allies_changed();
   while (*al_p) {
     al = *al_p;
     if (al->faction==f) return al;
@@ -27,6 +29,7 @@ ally * ally_add(ally **al_p, struct faction *f) {
 
 void ally_remove(ally **al_p, struct faction *f) {
   ally * al;
+  allies_changed();
   while (*al_p) {
     al = *al_p;
     if (al->faction==f) {
@@ -107,13 +107,8 @@ int turn = -1;
 
 int NewbieImmunity(void)
 {
-    static int value = -1;
-    static int gamecookie = -1;
-    if (value < 0 || gamecookie != global.cookie) {
-        gamecookie = global.cookie;
-        value = get_param_int(global.parameters, "NewbieImmunity", 0);
-    }
-    return value;
+    static rule_int rule = RULE_INT("NewbieImmunity", 0);
+    return rule_get_int(&rule);
 }
 
 bool IsImmune(const faction * f)
@@ -138,15 +133,27 @@ static int ally_flag(const char *s, int help_mask)
     return 0;
 }
 
-bool ExpensiveMigrants(void)
+/** parses a space-separated list of help modes into HELP_* flags */
+static int parse_help_flags(const char *str, int def)
 {
-    static int value = -1;
-    static int gamecookie = -1;
-    if (value < 0 || gamecookie != global.cookie) {
-        gamecookie = global.cookie;
-        value = get_param_int(global.parameters, "study.expensivemigrants", 0);
+    int flags = 0;
+    if (str != NULL) {
+        char *sstr = _strdup(str);
+        char *tok = strtok(sstr, " ");
+        while (tok) {
+            flags |= ally_flag(tok, -1);
+            tok = strtok(NULL, " ");
+        }
+        free(sstr);
+        return flags;
     }
-    return value;
+    return def;
+}
+
+bool ExpensiveMigrants(void)
+{
+    static rule_int rule = RULE_INT("study.expensivemigrants", 0);
+    return rule_get_int(&rule) != 0;
 }
 
 /** Specifies automatic alliance modes.
@@ -155,23 +162,8 @@ bool ExpensiveMigrants(void)
  */
 int AllianceAuto(void)
 {
-    static int value = -1;
-    static int gamecookie = -1;
-    if (value < 0 || gamecookie != global.cookie) {
-        const char *str = get_param(global.parameters, "alliance.auto");
-        gamecookie = global.cookie;
-        value = 0;
-        if (str != NULL) {
-            char *sstr = _strdup(str);
-            char *tok = strtok(sstr, " ");
-            while (tok) {
-                value |= ally_flag(tok, -1);
-                tok = strtok(NULL, " ");
-            }
-            free(sstr);
-        }
-    }
-    return value & HelpMask();
+    static rule_int rule = RULE_PARSE("alliance.auto", 0, parse_help_flags);
+    return rule_get_int(&rule) & HelpMask();
 }
 
 /** Limits the available help modes
@@ -182,54 +174,19 @@ int AllianceAuto(void)
  */
 int HelpMask(void)
 {
-    static int rule = -1;
-    static int gamecookie = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        const char *str = get_param(global.parameters, "rules.help.mask");
-        gamecookie = global.cookie;
-        rule = 0;
-        if (str != NULL) {
-            char *sstr = _strdup(str);
-            char *tok = strtok(sstr, " ");
-            while (tok) {
-                rule |= ally_flag(tok, -1);
-                tok = strtok(NULL, " ");
-            }
-            free(sstr);
-        }
-        else {
-            rule = HELP_ALL;
-        }
-    }
-    return rule;
+    static rule_int rule = RULE_PARSE("rules.help.mask", HELP_ALL, parse_help_flags);
+    return rule_get_int(&rule);
 }
 
 int AllianceRestricted(void)
 {
-    static int rule = -1;
-    static int gamecookie = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        const char *str = get_param(global.parameters, "alliance.restricted");
-        gamecookie = global.cookie;
-        rule = 0;
-        if (str != NULL) {
-            char *sstr = _strdup(str);
-            char *tok = strtok(sstr, " ");
-            while (tok) {
-                rule |= ally_flag(tok, -1);
-                tok = strtok(NULL, " ");
-            }
-            free(sstr);
-        }
-        rule &= HelpMask();
-    }
-    return rule;
+    static rule_int rule = RULE_PARSE("alliance.restricted", 0, parse_help_flags);
+    return rule_get_int(&rule) & HelpMask();
 }
 
 int LongHunger(const struct unit *u)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
+    static rule_int rule = RULE_INT("hunger.long", 0);
     if (u != NULL) {
         if (!fval(u, UFL_HUNGER))
             return false;
@@ -238,35 +195,21 @@ int LongHunger(const struct unit *u)
             return false;
 #endif
     }
-    if (rule < 0 || gamecookie != global.cookie) {
-        gamecookie = global.cookie;
-        rule = get_param_int(global.parameters, "hunger.long", 0);
-    }
-    return rule;
+    return rule_get_int(&rule);
 }
 
 int SkillCap(skill_t sk)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
+    static rule_int rule = RULE_INT("skill.maxlevel", 0);
     if (sk == SK_MAGIC)
         return 0;                   /* no caps on magic */
-    if (rule < 0 || gamecookie != global.cookie) {
-        gamecookie = global.cookie;
-        rule = get_param_int(global.parameters, "skill.maxlevel", 0);
-    }
-    return rule;
+    return rule_get_int(&rule);
 }
 
 int NMRTimeout(void)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        gamecookie = global.cookie;
-        rule = get_param_int(global.parameters, "nmr.timeout", 0);
-    }
-    return rule;
+    static rule_int rule = RULE_INT("nmr.timeout", 0);
+    return rule_get_int(&rule);
 }
 
 race_t old_race(const struct race * rc)
@@ -415,8 +358,8 @@ static attrib_type at_maxmagicians = {
 
 int max_magicians(const faction * f)
 {
-    int m =
-        get_param_int(global.parameters, "rules.maxskills.magic", MAXMAGICIANS);
+    static rule_int rule = RULE_INT("rules.maxskills.magic", MAXMAGICIANS);
+    int m = rule_get_int(&rule);
     attrib *a;
 
     if ((a = a_find(f->attribs, &at_maxmagicians)) != NULL) {
@@ -448,11 +391,8 @@ FILE *debug;
 
 static int ShipSpeedBonus(const unit * u)
 {
-    static int level = -1;
-    if (level == -1) {
-        level =
-            get_param_int(global.parameters, "movement.shipspeed.skillbonus", 0);
-    }
+    static rule_int rule = RULE_INT("movement.shipspeed.skillbonus", 0);
+    int level = rule_get_int(&rule);
     if (level > 0) {
         ship *sh = u->ship;
         int skl = effskill(u, SK_SAILING);
@@ -680,13 +620,14 @@ static void init_gms(void)
     }
 }
 
+static bool gms_init;
+
 static int
 autoalliance(const plane * pl, const faction * sf, const faction * f2)
 {
-    static bool init = false;
-    if (!init) {
+    if (!gms_init) {
         init_gms();
-        init = true;
+        gms_init = true;
     }
     if (pl && (pl->flags & PFL_FRIENDLY))
         return HELP_ALL;
@@ -741,24 +682,159 @@ const struct faction *f2, const struct ally *sf, int mode)
     return mode;
 }
 
+/* the help modes of every faction and every group towards all factions,
+ * so alliedunit() does not have to walk the ally lists, alliances and
+ * attributes for each query. a row holds the result of alliedgroup() for
+ * all modes at once, which is enough because the result is just the mode
+ * masked by it. planes that are friendly or have a GM are rare and not
+ * in the matrix. allies_changed() throws it away, it gets rebuilt on the
+ * next query.
+ */
+#define HELP_MODES (HELP_ALL|HELP_OBSERVE|HELP_TRAVEL)
+
+static unsigned char *ally_matrix;
+static faction **ally_factions;
+static group **ally_groups;
+static int ally_nfactions, ally_ngroups;
+static bool ally_valid;
+static int ally_cookie;
+static int ally_queries, ally_rebuilds;
+
+void allies_changed(void)
+{
+    ally_valid = false;
+}
+
+void ally_stats(int *queries, int *rebuilds)
+{
+    if (queries) *queries = ally_queries;
+    if (rebuilds) *rebuilds = ally_rebuilds;
+    ally_queries = ally_rebuilds = 0;
+}
+
+static int ally_column(const faction * f)
+{
+    if (f->index >= 0 && f->index < ally_nfactions && ally_factions[f->index] == f) {
+        return f->index;
+    }
+    return -1;
+}
+
+static void ally_fill(unsigned char *row, const faction * f, const ally * sf,
+    const bool *npc)
+{
+    const alliance *al = f_get_alliance(f);
+    int i, automode = AllianceAuto(), restricted = AllianceRestricted();
+
+    for (i = 0; i != ally_nfactions; ++i) {
+        const faction *f2 = ally_factions[i];
+        row[i] = (unsigned char)((al && automode && f->alliance == f2->alliance) ? automode : 0);
+    }
+    for (; sf; sf = sf->next) {
+        /* like alliedgroup, only the first entry for a faction counts */
+        i = sf->faction ? ally_column(sf->faction) : -1;
+        if (i >= 0 && !(row[i] & 0x80)) {
+            row[i] |= (unsigned char)(0x80 | (sf->status & HELP_MODES));
+        }
+    }
+    for (i = 0; i != ally_nfactions; ++i) {
+        row[i] &= HELP_MODES;
+        if (restricted && !npc[f->index] && !npc[i]
+            && f->alliance != ally_factions[i]->alliance) {
+            row[i] &= ~restricted;
+        }
+    }
+}
+
+static void ally_build(void)
+{
+    faction *f;
+    group *g;
+    bool *npc;
+    int nf = 0, ng = 0;
+    size_t size;
+
+    if (!gms_init) {
+        init_gms();
+        gms_init = true;
+    }
+    for (f = factions; f; f = f->next) {
+        ++nf;
+        for (g = f->groups; g; g = g->next) {
+            ++ng;
+        }
+    }
+    size = (size_t)nf * (nf + ng);
+    ally_factions = (faction **)realloc(ally_factions, (nf + 1) * sizeof(faction *));
+    ally_groups = (group **)realloc(ally_groups, (ng + 1) * sizeof(group *));
+    ally_matrix = (unsigned char *)realloc(ally_matrix, size + 1);
+    npc = (bool *)malloc((nf + 1) * sizeof(bool));
+    ally_nfactions = nf;
+    ally_ngroups = ng;
+
+    nf = ng = 0;
+    for (f = factions; f; f = f->next) {
+        npc[nf] = a_findc(f->attribs, &at_npcfaction) != NULL;
+        f->index = nf;
+        ally_factions[nf++] = f;
+        for (g = f->groups; g; g = g->next) {
+            g->index = ng;
+            ally_groups[ng++] = g;
+        }
+    }
+    for (f = factions; f; f = f->next) {
+        ally_fill(ally_matrix + (size_t)f->index * nf, f, f->allies, npc);
+        for (g = f->groups; g; g = g->next) {
+            ally_fill(ally_matrix + (size_t)(nf + g->index) * nf, f, g->allies, npc);
+        }
+    }
+    free(npc);
+    ally_valid = true;
+    ally_cookie = global.cookie;
+    ++ally_rebuilds;
+}
+
+static int
+allied(const plane * pl, const faction * f, const group * g,
+const faction * f2, int mode)
+{
+    ++ally_queries;
+    if (!ally_valid || ally_cookie != global.cookie) {
+        ally_build();
+    }
+    if (!fval(f2, FFL_GM) && !(pl && (pl->flags & PFL_FRIENDLY))) {
+        int col = ally_column(f2);
+        if (col >= 0) {
+            if (g) {
+                if (g->index >= 0 && g->index < ally_ngroups && ally_groups[g->index] == g) {
+                    size_t row = (size_t)(ally_nfactions + g->index);
+                    return mode & ally_matrix[row * ally_nfactions + col];
+                }
+            }
+            else if (ally_column(f) >= 0) {
+                return mode & ally_matrix[(size_t)f->index * ally_nfactions + col];
+            }
+        }
+    }
+    return alliedgroup(pl, f, f2, g ? g->allies : f->allies, mode);
+}
+
 int
 alliedfaction(const struct plane *pl, const struct faction *f,
 const struct faction *f2, int mode)
 {
-    return alliedgroup(pl, f, f2, f->allies, mode);
+    return allied(pl, f, NULL, f2, mode);
 }
 
 /* Die Gruppe von Einheit u hat helfe zu f2 gesetzt. */
 int alliedunit(const unit * u, const faction * f2, int mode)
 {
-    ally *sf;
-    int automode;
-
     assert(u->region);            /* the unit should be in a region, but it's possible that u->number==0 (TEMP units) */
     if (u->faction == f2)
         return mode;
     if (u->faction != NULL && f2 != NULL) {
         plane *pl;
+        group *g = NULL;
 
         if (mode & HELP_FIGHT) {
             if ((u->flags & UFL_DEFENDER) || (u->faction->flags & FFL_DEFENDER)) {
@@ -771,18 +847,17 @@ int alliedunit(const unit * u, const faction * f2, int mode)
         }
 
         pl = rplane(u->region);
-        automode = mode & autoalliance(pl, u->faction, f2);
-
-        if (pl != NULL && (pl->flags & PFL_NOALLIANCES))
+        if (pl != NULL && (pl->flags & PFL_NOALLIANCES)) {
+            int automode = mode & autoalliance(pl, u->faction, f2);
             mode = (mode & automode) | (mode & HELP_GIVE);
+        }
 
-        sf = u->faction->allies;
         if (fval(u, UFL_GROUP)) {
             const attrib *a = a_findc(u->attribs, &at_group);
             if (a != NULL)
-                sf = ((group *)a->data.v)->allies;
+                g = (group *)a->data.v;
         }
-        return alliedgroup(pl, u->faction, f2, sf, mode);
+        return allied(pl, u->faction, g, f2, mode);
     }
     return 0;
 }
@@ -796,6 +871,102 @@ seefaction(const faction * f, const region * r, const unit * u, int modifier)
     return false;
 }
 
+/* while reports are written, nobody moves or learns, so for each region
+ * we can remember the best perception every faction has there, once for
+ * all its units and once for those carrying an amulet of true seeing.
+ * cansee() then does not have to walk the region's units for each target.
+ */
+typedef struct presence {
+    const faction *f;
+    int observation;
+    int observation_aots;       /* INT_MIN if nobody has an amulet */
+} presence;
+
+typedef struct region_presence {
+    int size;
+    presence *factions;
+} region_presence;
+
+static bool presence_enabled;
+static region_presence **presence_regions;
+static unsigned int presence_max;
+
+static region_presence *build_presence(const region * r)
+{
+    const resource_type *rtype = get_resourcetype(R_AMULET_OF_TRUE_SEEING);
+    region_presence *rp = (region_presence *)calloc(1, sizeof(region_presence));
+    int maxsize = 0;
+    unit *u;
+
+    for (u = r->units; u; u = u->next) {
+        presence *p;
+        int i, o;
+        for (i = 0; i != rp->size && rp->factions[i].f != u->faction; ++i);
+        if (i == rp->size) {
+            if (rp->size == maxsize) {
+                maxsize = maxsize ? maxsize * 2 : 4;
+                rp->factions = (presence *)realloc(rp->factions, maxsize * sizeof(presence));
+            }
+            p = rp->factions + rp->size++;
+            p->f = u->faction;
+            p->observation = p->observation_aots = INT_MIN;
+        }
+        else {
+            p = rp->factions + i;
+        }
+        o = eff_skill(u, SK_PERCEPTION, r);
+        if (o > p->observation) {
+            p->observation = o;
+        }
+        if (o > p->observation_aots && rtype && rtype->itype && i_get(u->items, rtype->itype) > 0) {
+            p->observation_aots = o;
+        }
+    }
+    return rp;
+}
+
+static const presence *find_presence(const faction * f, const region * r)
+{
+    region_presence *rp;
+    int i;
+
+    if (r->index >= presence_max) {
+        unsigned int size = presence_max ? presence_max : 1024;
+        while (size <= r->index) size *= 2;
+        presence_regions = (region_presence **)realloc(presence_regions, size * sizeof(region_presence *));
+        memset(presence_regions + presence_max, 0, (size - presence_max) * sizeof(region_presence *));
+        presence_max = size;
+    }
+    rp = presence_regions[r->index];
+    if (!rp) {
+        rp = presence_regions[r->index] = build_presence(r);
+    }
+    for (i = 0; i != rp->size; ++i) {
+        if (rp->factions[i].f == f) {
+            return rp->factions + i;
+        }
+    }
+    return NULL;
+}
+
+/** turns the presence index for cansee() on or off.
+ * only enable it while no unit changes its region, skills or items.
+ */
+void cansee_index(bool enable)
+{
+    unsigned int i;
+    for (i = 0; i != presence_max; ++i) {
+        if (presence_regions[i]) {
+            free(presence_regions[i]->factions);
+            free(presence_regions[i]);
+        }
+    }
+    free(presence_regions);
+    presence_regions = NULL;
+    presence_max = 0;
+    presence_enabled = enable;
+}
+
 bool
 cansee(const faction * f, const region * r, const unit * u, int modifier)
 /* r kann != u->region sein, wenn es um durchreisen geht */
@@ -825,6 +996,26 @@ cansee(const faction * f, const region * r, const unit * u, int modifier)
     if (leftship(u))
         return true;
 
+    if (presence_enabled) {
+        const presence *p = find_presence(f, r);
+        int observation;
+        if (!p) {
+            return false;
+        }
+        if (is_guard(u, GUARD_ALL) != 0 || usiege(u) || u->building || u->ship) {
+            return true;
+        }
+        rings = invisible(u, NULL);
+        if (u->number <= 0) {
+            return false;
+        }
+        observation = (rings < u->number) ? p->observation : p->observation_aots;
+        if (!skill_enabled(SK_PERCEPTION)) {
+            return observation != INT_MIN;
+        }
+        return observation != INT_MIN && observation >= eff_stealth(u, r) - modifier;
+    }
+
     while (u2 && u2->faction != f)
         u2 = u2->next;
     if (u2 == NULL)
@@ -924,6 +1115,16 @@ int modifier)
             return true;
         }
 
+        if (presence_enabled) {
+            const presence *p = find_presence(f, r);
+            int o;
+            if (!p) {
+                return false;
+            }
+            o = (rings < u->number) ? p->observation : p->observation_aots;
+            return o != INT_MIN && o >= n;
+        }
+
         for (u2 = r->units; u2; u2 = u2->next) {
             if (u2->faction == f) {
                 int o;
@@ -1047,11 +1248,9 @@ int count_migrants(const faction * f)
 
 int count_maxmigrants(const faction * f)
 {
-    static int migrants = -1;
+    static rule_int rule = RULE_INT("rules.migrants", INT_MAX);
+    int migrants = rule_get_int(&rule);
 
-    if (migrants < 0) {
-        migrants = get_param_int(global.parameters, "rules.migrants", INT_MAX);
-    }
     if (migrants == INT_MAX) {
         int x = 0;
         if (f->race == get_race(RC_HUMAN)) {
@@ -1928,6 +2127,30 @@ float get_param_flt(const struct param *p, const char *key, float def)
     return str ? (float)atof(str) : def;
 }
 
+int rule_get_int(rule_int *rule)
+{
+    if (rule->cookie != global.cookie) {
+        if (rule->parse) {
+            const char *str = get_param(global.parameters, rule->key);
+            rule->value = rule->parse(str, rule->def);
+        }
+        else {
+            rule->value = get_param_int(global.parameters, rule->key, rule->def);
+        }
+        rule->cookie = global.cookie;
+    }
+    return rule->value;
+}
+
+float rule_get_flt(rule_flt *rule)
+{
+    if (rule->cookie != global.cookie) {
+        rule->value = get_param_flt(global.parameters, rule->key, rule->def);
+        rule->cookie = global.cookie;
+    }
+    return rule->value;
+}
+
 void set_param(struct param **p, const char *key, const char *data)
 {
     struct param *par;
@@ -1958,6 +2181,7 @@ void kernel_done(void)
      * calling it is optional, e.g. a release server will most likely not do it.
      */
     translation_done();
+    messages_done();
     gc_done();
 }
 
@@ -2286,89 +2510,58 @@ int cmp_current_owner(const building * b, const building * a)
 
 int rule_stealth_faction(void)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        rule = get_param_int(global.parameters, "rules.stealth.faction", 0xFF);
-        gamecookie = global.cookie;
-        assert(rule >= 0);
-    }
-    return rule;
+    static rule_int rule = RULE_INT("rules.stealth.faction", 0xFF);
+    int value = rule_get_int(&rule);
+    assert(value >= 0);
+    return value;
 }
 
 int rule_region_owners(void)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        rule = get_param_int(global.parameters, "rules.region_owners", 0);
-        gamecookie = global.cookie;
-        assert(rule >= 0);
-    }
-    return rule;
+    static rule_int rule = RULE_INT("rules.region_owners", 0);
+    int value = rule_get_int(&rule);
+    assert(value >= 0);
+    return value;
 }
 
 int rule_auto_taxation(void)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        rule =
-            get_param_int(global.parameters, "rules.economy.taxation", TAX_ORDER);
-        gamecookie = global.cookie;
-        assert(rule >= 0);
-    }
-    return rule;
+    static rule_int rule = RULE_INT("rules.economy.taxation", TAX_ORDER);
+    int value = rule_get_int(&rule);
+    assert(value >= 0);
+    return value;
 }
 
 int rule_blessed_harvest(void)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        rule =
-            get_param_int(global.parameters, "rules.magic.blessed_harvest",
-            HARVEST_WORK);
-        gamecookie = global.cookie;
-        assert(rule >= 0);
-    }
-    return rule;
+    static rule_int rule = RULE_INT("rules.magic.blessed_harvest", HARVEST_WORK);
+    int value = rule_get_int(&rule);
+    assert(value >= 0);
+    return value;
 }
 
 int rule_alliance_limit(void)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        rule = get_param_int(global.parameters, "rules.limit.alliance", 0);
-        gamecookie = global.cookie;
-        assert(rule >= 0);
-    }
-    return rule;
+    static rule_int rule = RULE_INT("rules.limit.alliance", 0);
+    int value = rule_get_int(&rule);
+    assert(value >= 0);
+    return value;
 }
 
 int rule_faction_limit(void)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        rule = get_param_int(global.parameters, "rules.limit.faction", 0);
-        gamecookie = global.cookie;
-        assert(rule >= 0);
-    }
-    return rule;
+    static rule_int rule = RULE_INT("rules.limit.faction", 0);
+    int value = rule_get_int(&rule);
+    assert(value >= 0);
+    return value;
 }
 
 int rule_transfermen(void)
 {
-    static int gamecookie = -1;
-    static int rule = -1;
-    if (rule < 0 || gamecookie != global.cookie) {
-        rule = get_param_int(global.parameters, "rules.transfermen", 1);
-        gamecookie = global.cookie;
-        assert(rule >= 0);
-    }
-    return rule;
+    static rule_int rule = RULE_INT("rules.transfermen", 1);
+    int value = rule_get_int(&rule);
+    assert(value >= 0);
+    return value;
 }
 
 static int
@@ -2609,12 +2802,14 @@ int entertainmoney(const region * r)
 
 int rule_give(void)
 {
-    return get_param_int(global.parameters, "rules.give", GIVE_DEFAULT);
+    static rule_int rule = RULE_INT("rules.give", GIVE_DEFAULT);
+    return rule_get_int(&rule);
 }
 
 int markets_module(void)
 {
-    return get_param_int(global.parameters, "modules.markets", 0);
+    static rule_int rule = RULE_INT("modules.markets", 0);
+    return rule_get_int(&rule);
 }
 
 /** releases all memory associated with the game state.
@@ -2624,6 +2819,7 @@ int markets_module(void)
 void free_gamedata(void)
 {
     int i;
+    closegame();
     free_units();
     free_regions();
     free_borders();
@@ -162,6 +162,7 @@ extern "C" {
         const struct unit *u, int modifier);
     bool cansee_unit(const struct unit *u, const struct unit *target,
         int modifier);
+    void cansee_index(bool enable);
     bool seefaction(const struct faction *f, const struct region *r,
         const struct unit *u, int modifier);
 
@@ -192,6 +193,8 @@ extern "C" {
         const struct faction *f2, int mode);
     int alliedgroup(const struct plane *pl, const struct faction *f,
         const struct faction *f2, const struct ally *sf, int mode);
+    void allies_changed(void);
+    void ally_stats(int *queries, int *rebuilds);
 
     struct faction *findfaction(int n);
     struct faction *getfaction(void);
@@ -372,6 +375,34 @@ extern "C" {
     int check_param(const struct param *p, const char *key, const char *searchvalue);
     float get_param_flt(const struct param *p, const char *key, float def);
 
+    /* typed handles for game rules: declare one static handle per rule,
+     * its value is parsed from global.parameters on first use and again
+     * only when global.cookie changes. an optional parse function turns
+     * the raw string (or NULL if unset) into flags or other int values.
+     */
+    typedef struct rule_int {
+        const char *key;
+        int def;
+        int(*parse) (const char *str, int def);
+        int cookie;
+        int value;
+    } rule_int;
+
+    typedef struct rule_flt {
+        const char *key;
+        float def;
+        int cookie;
+        float value;
+    } rule_flt;
+
+#define RULE_INT(key, def) { key, def, NULL, -1, 0 }
+#define RULE_PARSE(key, def, parse) { key, def, parse, -1, 0 }
+#define RULE_FLT(key, def) { key, def, -1, 0.0F }
+
+    int rule_get_int(rule_int *rule);
+    float rule_get_flt(rule_flt *rule);
+
+
     bool ExpensiveMigrants(void);
     int NMRTimeout(void);
     int LongHunger(const struct unit *u);
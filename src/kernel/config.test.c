@@ -2,6 +2,13 @@
 #include <stdlib.h>
 
 #include <kernel/config.h>
+#include <kernel/alliance.h>
+#include <kernel/ally.h>
+#include <kernel/faction.h>
+#include <kernel/group.h>
+#include <kernel/region.h>
+#include <skill.h>
+#include <kernel/unit.h>
 
 #include <CuTest.h>
 #include <tests.h>
@@ -39,11 +46,122 @@ static void test_param_flt(CuTest * tc)
     CuAssertDblEquals(tc, 42.0, get_param_flt(par, "bar", 0.0), 0.01);
 }
 
+static int parse_twice(const char *str, int def)
+{
+    return str ? atoi(str) * 2 : def;
+}
+
+static void test_rule_cache(CuTest * tc)
+{
+    static rule_int rint = RULE_INT("test.rule_int", 13);
+    static rule_int rparse = RULE_PARSE("test.rule_parse", 7, parse_twice);
+    static rule_flt rflt = RULE_FLT("test.rule_flt", 1.5F);
+    test_cleanup();
+    CuAssertIntEquals(tc, 13, rule_get_int(&rint));
+    CuAssertIntEquals(tc, 7, rule_get_int(&rparse));
+    CuAssertDblEquals(tc, 1.5, rule_get_flt(&rflt), 0.01);
+    set_param(&global.parameters, "test.rule_int", "23");
+    set_param(&global.parameters, "test.rule_parse", "21");
+    set_param(&global.parameters, "test.rule_flt", "0.5");
+    CuAssertIntEquals(tc, 23, rule_get_int(&rint));
+    CuAssertIntEquals(tc, 42, rule_get_int(&rparse));
+    CuAssertDblEquals(tc, 0.5, rule_get_flt(&rflt), 0.01);
+}
+
+static void test_cansee_index(CuTest * tc)
+{
+    faction *f1, *f2, *f3;
+    region *r;
+    unit *u1, *u2;
+    int level, seen = 0;
+
+    test_cleanup();
+    r = test_create_region(0, 0, 0);
+    f1 = test_create_faction(0);
+    f2 = test_create_faction(0);
+    f3 = test_create_faction(0);
+    u1 = test_create_unit(f1, r);
+    u2 = test_create_unit(f2, r);
+    test_create_unit(f2, r);
+    set_level(u1, SK_STEALTH, 3);
+
+    for (level = 0; level != 6; ++level) {
+        bool see, see_durch;
+        set_level(u2, SK_PERCEPTION, level);
+        see = cansee(f2, r, u1, 0);
+        if (see) ++seen;
+        see_durch = cansee_durchgezogen(f2, r, u1, 0);
+        cansee_index(true);
+        CuAssertIntEquals(tc, see, cansee(f2, r, u1, 0));
+        CuAssertIntEquals(tc, see_durch, cansee_durchgezogen(f2, r, u1, 0));
+        CuAssertTrue(tc, cansee(f1, r, u1, 0));
+        CuAssertTrue(tc, !cansee(f3, r, u1, 0));
+        cansee_index(false);
+    }
+    /* stealth 3 hides from the lower perception levels only */
+    CuAssertTrue(tc, seen > 0 && seen < 6);
+    test_cleanup();
+}
+
+static void test_ally_matrix(CuTest * tc)
+{
+    faction *f1, *f2, *f3;
+    region *r;
+    unit *u;
+    group *g;
+    alliance *al;
+    int queries, rebuilds;
+
+    test_cleanup();
+    r = test_create_region(0, 0, 0);
+    f1 = test_create_faction(0);
+    f2 = test_create_faction(0);
+    f3 = test_create_faction(0);
+    u = test_create_unit(f1, r);
+    ally_stats(NULL, NULL);
+
+    ally_add(&f1->allies, f2)->status = HELP_GIVE | HELP_MONEY;
+    CuAssertIntEquals(tc, HELP_GIVE | HELP_MONEY, alliedfaction(NULL, f1, f2, HELP_ALL));
+    CuAssertIntEquals(tc, HELP_GIVE, alliedunit(u, f2, HELP_GIVE));
+    CuAssertIntEquals(tc, 0, alliedfaction(NULL, f2, f1, HELP_ALL));
+    CuAssertIntEquals(tc, 0, alliedfaction(NULL, f1, f3, HELP_ALL));
+
+    /* a group starts with the faction's allies, then goes its own way */
+    join_group(u, "group");
+    g = get_group(u);
+    CuAssertPtrNotNull(tc, g);
+    CuAssertIntEquals(tc, HELP_GIVE | HELP_MONEY, alliedunit(u, f2, HELP_ALL));
+    ally_add(&g->allies, f3)->status = HELP_FIGHT;
+    CuAssertIntEquals(tc, HELP_FIGHT, alliedunit(u, f3, HELP_ALL));
+    CuAssertIntEquals(tc, 0, alliedfaction(NULL, f1, f3, HELP_ALL));
+
+    /* alliances, with automatic and restricted modes */
+    al = makealliance(1, "alliance");
+    setalliance(f1, al);
+    setalliance(f2, al);
+    set_param(&global.parameters, "alliance.auto", "fight");
+    CuAssertIntEquals(tc, HELP_FIGHT, alliedfaction(NULL, f2, f1, HELP_ALL));
+    set_param(&global.parameters, "alliance.restricted", "fight give");
+    ally_add(&f1->allies, f3)->status = HELP_GIVE | HELP_GUARD;
+    CuAssertIntEquals(tc, HELP_GUARD, alliedfaction(NULL, f1, f3, HELP_ALL));
+    CuAssertIntEquals(tc, HELP_GIVE | HELP_MONEY | HELP_FIGHT, alliedfaction(NULL, f1, f2, HELP_ALL));
+    CuAssertIntEquals(tc, alliedgroup(NULL, f1, f3, f1->allies, HELP_ALL), alliedfaction(NULL, f1, f3, HELP_ALL));
+    CuAssertIntEquals(tc, alliedgroup(NULL, f1, f3, g->allies, HELP_ALL), alliedunit(u, f3, HELP_ALL));
+
+    ally_stats(&queries, &rebuilds);
+    CuAssertIntEquals(tc, 12, queries);
+    CuAssertTrue(tc, rebuilds > 0 && rebuilds < queries);
+    test_cleanup();
+}
+
 CuSuite *get_config_suite(void)
 {
   CuSuite *suite = CuSuiteNew();
   SUITE_ADD_TEST(suite, test_get_set_param);
   SUITE_ADD_TEST(suite, test_param_int);
   SUITE_ADD_TEST(suite, test_param_flt);
+  SUITE_ADD_TEST(suite, test_rule_cache);
+  SUITE_ADD_TEST(suite, test_cansee_index);
+  SUITE_ADD_TEST(suite, test_ally_matrix);
   return suite;
 }
@@ -45,13 +45,33 @@ int nextborder = 0;
 
 #define BORDER_MAXHASH 8191
 connection *borders[BORDER_MAXHASH];
+static connection *border_ids[BORDER_MAXHASH];
 border_type *bordertypes;
 
 void (*border_convert_cb) (struct connection * con, struct attrib * attr) = 0;
 
+/* connections read by read_borders_deferred() whose regions are not
+ * loaded yet. they can be found by id, but not by their regions. */
+typedef struct pending_border {
+  struct pending_border *next;
+  connection *b;
+  int from, to;
+} pending_border;
+
+static pending_border *pending_borders;
+
 void free_borders(void)
 {
   int i;
+  while (pending_borders) {
+    pending_border *pb = pending_borders;
+    pending_borders = pb->next;
+    if (pb->b->type->destroy) {
+      pb->b->type->destroy(pb->b);
+    }
+    free(pb->b);
+    free(pb);
+  }
   for (i = 0; i != BORDER_MAXHASH; ++i) {
     while (borders[i]) {
       connection *b = borders[i];
@@ -67,22 +87,34 @@ void free_borders(void)
       }
     }
   }
+  memset(border_ids, 0, sizeof(border_ids));
+}
+
+static void bhash_id(connection * b)
+{
+  connection **bp = &border_ids[b->id % BORDER_MAXHASH];
+  b->nextid = *bp;
+  *bp = b;
+}
+
+static void bunhash_id(connection * b)
+{
+  connection **bp = &border_ids[b->id % BORDER_MAXHASH];
+  while (*bp && *bp != b) {
+    bp = &(*bp)->nextid;
+  }
+  if (*bp) {
+    *bp = b->nextid;
+  }
 }
 
 connection *find_border(int id)
 {
-  int key;
-  for (key = 0; key != BORDER_MAXHASH; key++) {
-    connection *bhash;
-    for (bhash = borders[key]; bhash != NULL; bhash = bhash->nexthash) {
-      connection *b;
-      for (b = bhash; b; b = b->next) {
-        if (b->id == id)
-          return b;
-      }
-    }
+  connection *b = border_ids[id % BORDER_MAXHASH];
+  while (b && b->id != id) {
+    b = b->nextid;
   }
-  return NULL;
+  return b;
 }
 
 int resolve_borderid(variant id, void *addr)
@@ -99,39 +131,38 @@ int resolve_borderid(variant id, void *addr)
     return result;
 }
 
-static void walk_i(region *r, connection *b, void(*cb)(connection *, void *), void *data) {
-    for (; b; b = b->nexthash) {
-        if (b->from == r || b->to == r) {
-            connection *bn;
-            for (bn = b; bn; bn = bn->next) {
-                cb(b, data);
-            }
-        }
-    }
-}
-
 void walk_connections(region *r, void(*cb)(connection *, void *), void *data) {
-    int key = reg_hashkey(r);
     int d;
 
-    walk_i(r, borders[key], cb, data);
     for (d = 0; d != MAXDIRECTIONS; ++d) {
         region *rn = r_connect(r, d);
-        int k = reg_hashkey(rn);
-        if (k < key) {
-            walk_i(r, borders[k], cb, data);
+        if (rn) {
+            connection *b;
+            for (b = get_borders(r, rn); b; b = b->next) {
+                cb(b, data);
+            }
         }
     }
 }
 
+/* connections are undirected for lookup, so the key combines the lower
+ * and the higher region index of the pair */
+static unsigned int border_hashkey(const region * r1, const region * r2)
+{
+  unsigned int k1 = (unsigned int)reg_hashkey(r1);
+  unsigned int k2 = (unsigned int)reg_hashkey(r2);
+  if (k1 > k2) {
+    unsigned int k = k1;
+    k1 = k2;
+    k2 = k;
+  }
+  return (k1 * 65599 + k2) % BORDER_MAXHASH;
+}
+
 static connection **get_borders_i(const region * r1, const region * r2)
 {
-  connection **bp;
-  int key = reg_hashkey(r1);
-  int k2 = reg_hashkey(r2);
+  connection **bp = &borders[border_hashkey(r1, r2)];
 
-  key = _min(k2, key) % BORDER_MAXHASH;
-  bp = &borders[key];
   while (*bp) {
     connection *b = *bp;
     if ((b->from == r1 && b->to == r2) || (b->from == r2 && b->to == r1))
@@ -147,7 +178,7 @@ connection *get_borders(const region * r1, const region * r2)
   return *bp;
 }
 
-connection *new_border(border_type * type, region * from, region * to)
+static connection *make_border(border_type * type, region * from, region * to, int id)
 {
   connection *b = calloc(1, sizeof(struct connection));
 
@@ -160,13 +191,19 @@ connection *new_border(border_type * type, region * from, region * to)
   b->type = type;
   b->from = from;
   b->to = to;
-  b->id = ++nextborder;
+  b->id = id;
+  bhash_id(b);
 
   if (type->init)
     type->init(b);
   return b;
 }
 
+connection *new_border(border_type * type, region * from, region * to)
+{
+  return make_border(type, from, to, ++nextborder);
+}
+
 void erase_border(connection * b)
 {
   if (b->from && b->to) {
@@ -188,6 +225,7 @@ void erase_border(connection * b)
       *bp = b->next;
     }
   }
+  bunhash_id(b);
   if (b->type->destroy) {
     b->type->destroy(b);
   }
@@ -595,10 +633,10 @@ void write_borders(struct storage *store)
   WRITE_TOK(store, "end");
 }
 
-int read_borders(struct storage *store)
+static int read_borders_i(struct storage *store, bool defer)
 {
   for (;;) {
-    int bid = 0;
+    int bid = 0, fid = 0, tid = 0;
     char zText[32];
     connection *b;
     region *from, *to;
@@ -617,7 +655,6 @@ int read_borders(struct storage *store)
       from = findregion(fx, fy);
       to = findregion(tx, ty);
     } else {
-      int fid, tid;
       READ_INT(store, &fid);
       READ_INT(store, &tid);
       from = findregionbyid(fid);
@@ -637,10 +674,19 @@ int read_borders(struct storage *store)
       if (r != NULL)
         to = r;
     }
-    b = new_border(type, from, to);
-    nextborder--;               /* new_border erhht den Wert */
-    b->id = bid;
     assert(bid <= nextborder);
+    if (defer && type && (!from || !to)) {
+      pending_border *pb = (pending_border *)malloc(sizeof(pending_border));
+      pb->b = make_border(type, NULL, NULL, bid);
+      pb->from = fid;
+      pb->to = tid;
+      pb->next = pending_borders;
+      pending_borders = pb;
+      if (type->read)
+        type->read(pb->b, store);
+      continue;
+    }
+    b = make_border(type, from, to, bid);
     if (type->read)
       type->read(b, store);
     if (global.data_version < NOBORDERATTRIBS_VERSION) {
@@ -661,3 +707,39 @@ int read_borders(struct storage *store)
   }
   return 0;
 }
+
+int read_borders(struct storage *store)
+{
+  return read_borders_i(store, false);
+}
+
+/** reads the connections like read_borders(), but keeps those between
+ * regions that are not loaded yet, until attach_borders() finds both.
+ */
+int read_borders_deferred(struct storage *store)
+{
+  return read_borders_i(store, true);
+}
+
+void attach_borders(void)
+{
+  pending_border **pbp = &pending_borders;
+  while (*pbp) {
+    pending_border *pb = *pbp;
+    region *from = findregionbyid(pb->from);
+    region *to = from ? findregionbyid(pb->to) : NULL;
+    if (to) {
+      connection **bp = get_borders_i(from, to);
+      while (*bp)
+        bp = &(*bp)->next;
+      *bp = pb->b;
+      pb->b->from = from;
+      pb->b->to = to;
+      *pbp = pb->next;
+      free(pb);
+    }
+    else {
+      pbp = &pb->next;
+    }
+  }
+}
@@ -31,6 +31,7 @@ extern "C" {
     struct border_type *type;   /* the type of this connection */
     struct connection *next;    /* next connection between these regions */
     struct connection *nexthash;        /* next connection between these regions */
+    struct connection *nextid;  /* next connection in the id hash */
     struct region *from, *to;   /* borders can be directed edges */
     variant data;
     int id;            /* unique id */
@@ -107,6 +108,8 @@ extern "C" {
   /* register a new bordertype */
 
   extern int read_borders(struct storage *store);
+  extern int read_borders_deferred(struct storage *store);
+  extern void attach_borders(void);
   extern void write_borders(struct storage *store);
   extern void age_borders(void);
 
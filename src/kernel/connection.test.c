@@ -0,0 +1,70 @@
+#include <platform.h>
+#include <kernel/config.h>
+#include "connection.h"
+#include "region.h"
+
+#include <CuTest.h>
+#include <tests.h>
+
+static border_type bt_test = {
+  "test", VAR_INT,
+  b_transparent,
+  NULL,                         /* init */
+  NULL,                         /* destroy */
+  b_read,                       /* read */
+  b_write,                      /* write */
+  b_blocknone,                  /* block */
+  NULL,                         /* name */
+  b_rvisible,                   /* rvisible */
+  b_fvisible,                   /* fvisible */
+  b_uvisible,                   /* uvisible */
+};
+
+static void count_connection(connection *b, void *data)
+{
+  int *count = (int *)data;
+  unused_arg(b);
+  ++*count;
+}
+
+static void test_find_border(CuTest * tc)
+{
+  region *r1, *r2, *r3;
+  connection *b1, *b2, *b3;
+  int id1, id3, count = 0;
+
+  test_cleanup();
+  r1 = test_create_region(0, 0, 0);
+  r2 = test_create_region(1, 0, 0);
+  r3 = test_create_region(0, 1, 0);
+  b1 = new_border(&bt_test, r1, r2);
+  b2 = new_border(&bt_test, r2, r1);
+  b3 = new_border(&bt_test, r1, r3);
+  CuAssertPtrEquals(tc, b1, find_border(b1->id));
+  CuAssertPtrEquals(tc, b2, find_border(b2->id));
+  CuAssertPtrEquals(tc, b3, find_border(b3->id));
+  CuAssertPtrEquals(tc, b1, get_borders(r1, r2));
+  CuAssertPtrEquals(tc, b1, get_borders(r2, r1));
+  CuAssertPtrEquals(tc, b2, b1->next);
+  CuAssertPtrEquals(tc, b3, get_borders(r3, r1));
+  CuAssertPtrEquals(tc, 0, get_borders(r2, r3));
+
+  walk_connections(r1, count_connection, &count);
+  CuAssertIntEquals(tc, 3, count);
+
+  id1 = b1->id;
+  id3 = b3->id;
+  erase_border(b1);
+  CuAssertPtrEquals(tc, 0, find_border(id1));
+  CuAssertPtrEquals(tc, b2, find_border(b2->id));
+  CuAssertPtrEquals(tc, b2, get_borders(r1, r2));
+  test_cleanup();
+  CuAssertPtrEquals(tc, 0, find_border(id3));
+}
+
+CuSuite *get_connection_suite(void)
+{
+  CuSuite *suite = CuSuiteNew();
+  SUITE_ADD_TEST(suite, test_find_border);
+  return suite;
+}
@@ -746,6 +746,19 @@ const char *oldcursename(int id)
     return oldnames[id];
 }
 
+/* is_cursed() is called in many inner loops, so the curse_type of an
+ * old curse id is only looked up by name once. curse types are never
+ * unregistered. */
+const curse_type *oldcursetype(int id)
+{
+    static const curse_type *oldtypes[MAXCURSE];
+    const curse_type *ct = oldtypes[id];
+    if (!ct) {
+        ct = oldtypes[id] = ct_find(oldnames[id]);
+    }
+    return ct;
+}
+
 /* ------------------------------------------------------------- */
 message *cinfo_simple(const void *obj, objtype_t typ, const struct curse * c,
     int self)
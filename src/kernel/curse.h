@@ -308,13 +308,14 @@ extern "C" {
 
 /*** COMPATIBILITY MACROS. DO NOT USE FOR NEW CODE, REPLACE IN OLD CODE: */
   extern const char *oldcursename(int id);
+  extern const curse_type *oldcursetype(int id);
   extern struct message *cinfo_simple(const void *obj, objtype_t typ,
     const struct curse *c, int self);
 
 #define is_cursed(a, id, id2) \
-  curse_active(get_curse(a, ct_find(oldcursename(id))))
+  curse_active(get_curse(a, oldcursetype(id)))
 #define get_curseeffect(a, id, id2) \
-  curse_geteffect(get_curse(a, ct_find(oldcursename(id))))
+  curse_geteffect(get_curse(a, oldcursetype(id)))
 
 /* eressea-defined attribute-type flags */
 #define ATF_CURSE  ATF_USER_DEFINED
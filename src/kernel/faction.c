@@ -49,6 +49,7 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include <util/variant.h>
 #include <util/unicode.h>
 #include <attributes/otherfaction.h>
+#include <reports.h>
 
 #include <storage.h>
 
@@ -84,6 +85,7 @@ void free_faction(faction * f)
         free_group(g);
     }
     freelist(f->allies);
+    allies_changed();
 
     free(f->email);
     free(f->banner);
@@ -97,6 +99,11 @@ void free_faction(faction * f)
     i_freeall(&f->items);
 
     freelist(f->ursprung);
+
+    if (f->seen) {
+        seen_free(f->seen);
+        f->seen = NULL;
+    }
 }
 
 void set_show_item(faction * f, const struct item_type *itype)
@@ -240,6 +247,7 @@ faction *addfaction(const char *email, const char *password,
     }
     addlist(&factions, f);
     fhash(f);
+    allies_changed();
 
     slprintf(buf, sizeof(buf), "%s %s", LOC(loc, "factiondefault"), factionid(f));
     f->name = _strdup(buf);
@@ -389,6 +397,7 @@ void destroyfaction(faction * f)
             }
         }
     }
+    allies_changed();
 
     /* units of other factions that were disguised as this faction
      * have their disguise replaced by ordinary faction hiding. */
@@ -422,6 +431,7 @@ int get_alliance(const faction * a, const faction * b)
 void set_alliance(faction * a, faction * b, int status)
 {
     ally **sfp;
+    allies_changed();
     sfp = &a->allies;
     while (*sfp) {
         ally *sf = *sfp;
@@ -558,11 +568,8 @@ static int allied_skillcount(const faction * f, skill_t sk)
 
 static int allied_skilllimit(const faction * f, skill_t sk)
 {
-    static int value = -1;
-    if (value < 0) {
-        value = get_param_int(global.parameters, "alliance.skilllimit", 0);
-    }
-    return value;
+    static rule_int rule = RULE_INT("alliance.skilllimit", 0);
+    return rule_get_int(&rule);
 }
 
 int count_skill(faction * f, skill_t sk)
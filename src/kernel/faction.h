@@ -28,7 +28,7 @@ extern "C" {
 
   struct alliance;
   struct item;
-  struct seen_region;
+  struct seen_data;
 
 /* SMART_INTERVALS: define to speed up finding the interval of regions that a 
    faction is in. defining this speeds up the turn by 30-40% */
@@ -65,6 +65,7 @@ typedef struct faction {
     struct region *last;
 #endif
     int no;
+    int index;                  /* position in the help matrix, see allied() */
     int subscription;
     int flags;
     char *name;
@@ -106,7 +107,7 @@ typedef struct faction {
       struct message_list *msgs;
     } *battles;
     struct item *items;         /* items this faction can claim */
-    struct seen_region **seen;
+    struct seen_data *seen;
     struct quicklist *seen_factions;
 } faction;
 
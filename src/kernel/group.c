@@ -57,6 +57,7 @@ static group *new_group(faction * f, const char *name, int gid)
   while (*gp)
     gp = &(*gp)->next;
   *gp = g;
+  allies_changed();
 
   maxgid = _max(gid, maxgid);
   g->name = _strdup(name);
@@ -130,6 +131,7 @@ void free_group(group * g)
     g_ptr = &(*g_ptr)->nexthash;
   assert(*g_ptr == g);
   *g_ptr = g->nexthash;
+  allies_changed();
 
   while (g->allies) {
     ally *a = g->allies;
@@ -36,6 +36,7 @@ extern "C" {
     struct ally *allies;
     int flags;
     int gid;
+    int index;                  /* position in the help matrix */
     int members;
   } group;
 
@@ -108,22 +108,14 @@ attrib_type at_reportspell = {
 
 static float MagicRegeneration(void)
 {
-    static float value = -1.0;
-    if (value < 0) {
-        const char *str = get_param(global.parameters, "magic.regeneration");
-        value = str ? (float)atof(str) : 1.0F;
-    }
-    return value;
+    static rule_flt rule = RULE_FLT("magic.regeneration", 1.0F);
+    return rule_get_flt(&rule);
 }
 
 float MagicPower(void)
 {
-    static float value = -1.0;
-    if (value < 0) {
-        const char *str = get_param(global.parameters, "magic.power");
-        value = str ? (float)atof(str) : 1.0f;
-    }
-    return value;
+    static rule_flt rule = RULE_FLT("magic.power", 1.0F);
+    return rule_get_flt(&rule);
 }
 
 static int a_readicastle(attrib * a, void *owner, struct storage *store)
@@ -213,12 +205,8 @@ static void free_mage(attrib * a)
 
 int FactionSpells(void)
 {
-    static int rules_factionspells = -1;
-    if (rules_factionspells < 0) {
-        rules_factionspells =
-            get_param_int(global.parameters, "rules.magic.factionlist", 0);
-    }
-    return rules_factionspells;
+    static rule_int rule = RULE_INT("rules.magic.factionlist", 0);
+    return rule_get_int(&rule);
 }
 
 void read_spells(struct quicklist **slistp, magic_t mtype,
@@ -1031,7 +1019,7 @@ spellpower(region * r, unit * u, const spell * sp, int cast_level, struct order
 {
     curse *c;
     float force = (float)cast_level;
-    int elf_power;
+    static rule_int rule_elf_power = RULE_INT("rules.magic.elfpower", 0);
     const struct resource_type *rtype;
 
     if (sp == NULL) {
@@ -1044,9 +1032,7 @@ spellpower(region * r, unit * u, const spell * sp, int cast_level, struct order
         if (btype && btype->flags & BTF_MAGIC) ++force;
     }
 
-    elf_power = get_param_int(global.parameters, "rules.magic.elfpower", 0);
-
-    if (elf_power && u_race(u) == get_race(RC_ELF) && r_isforest(r)) {
+    if (rule_get_int(&rule_elf_power) && u_race(u) == get_race(RC_ELF) && r_isforest(r)) {
         ++force;
     }
     rtype = rt_find("rop");
@@ -1,6 +1,7 @@
 #include <platform.h>
 
 #include <kernel/types.h>
+#include <kernel/config.h>
 #include <kernel/faction.h>
 #include <kernel/item.h>
 #include <kernel/magic.h>
@@ -373,6 +374,16 @@ void test_hasspell(CuTest * tc)
   CuAssertTrue(tc, !u_hasspell(u, sp));
 }
 
+static void test_magic_power(CuTest *tc)
+{
+  test_cleanup();
+  CuAssertDblEquals(tc, 1.0, MagicPower(), 0.01);
+  set_param(&global.parameters, "magic.power", "2.5");
+  CuAssertDblEquals(tc, 2.5, MagicPower(), 0.01);
+  set_param(&global.parameters, "magic.power", "1.0");
+  CuAssertDblEquals(tc, 1.0, MagicPower(), 0.01);
+}
+
 CuSuite *get_magic_suite(void)
 {
   CuSuite *suite = CuSuiteNew();
@@ -387,5 +398,6 @@ CuSuite *get_magic_suite(void)
   SUITE_ADD_TEST(suite, test_set_main_combatspell);
   SUITE_ADD_TEST(suite, test_set_post_combatspell);
   SUITE_ADD_TEST(suite, test_hasspell);
+  SUITE_ADD_TEST(suite, test_magic_power);
   return suite;
 }
@@ -57,55 +57,35 @@ typedef struct msg_setting {
 #include "region.h"
 #include <kernel/config.h>
 
-static void
-arg_set(variant args[], const message_type * mtype, const char *buffer,
-  variant v)
-{
-  int i;
-  for (i = 0; i != mtype->nparameters; ++i) {
-    if (!strcmp(buffer, mtype->pnames[i]))
-      break;
-  }
-  if (i != mtype->nparameters) {
-    args[i] = v;
-  } else {
-    log_error("invalid parameter %s for message type %s\n", buffer,
-      mtype->name);
-    assert(!"program aborted.");
-  }
-}
-
-struct message *msg_feedback(const struct unit *u, struct order *ord,
-  const char *name, const char *sig, ...)
-{
-  va_list marker;
-  const message_type *mtype = mt_find(name);
-  char paramname[64];
-  const char *ic = sig;
-  variant args[16];
-  variant var;
-  memset(args, 0, sizeof(args));
+/* msg_message() and msg_feedback() are called with a string literal for
+ * the signature, so the mapping from signature to parameter slots can be
+ * computed once per call site and looked up by pointer afterwards.
+ */
+#define MAXSIGARGS 16
+#define MAXSIGHASH 2039
 
-  if (ord == NULL)
-    ord = u->thisorder;
+typedef struct msg_signature {
+  struct msg_signature *next;
+  const message_type *mtype;
+  const char *sig;
+  int nargs;
+  int slots[MAXSIGARGS];
+} msg_signature;
 
-  if (!mtype) {
-    log_error("trying to create message of unknown type \"%s\"\n", name);
-    return msg_message("missing_feedback", "unit region command name", u,
-      u->region, ord, name);
-  }
+static msg_signature *signatures[MAXSIGHASH];
 
-  var.v = (void *)u;
-  arg_set(args, mtype, "unit", var);
-  var.v = (void *)u->region;
-  arg_set(args, mtype, "region", var);
-  var.v = (void *)ord;
-  arg_set(args, mtype, "command", var);
+static msg_signature *make_signature(const message_type * mtype, const char *sig)
+{
+  msg_signature *ms = (msg_signature *)malloc(sizeof(msg_signature));
+  const char *ic = sig;
 
-  va_start(marker, sig);
+  ms->mtype = mtype;
+  ms->sig = sig;
+  ms->nargs = 0;
   while (*ic && !isalnum(*ic))
     ic++;
   while (*ic) {
+    char paramname[64];
     char *oc = paramname;
     int i;
 
@@ -117,7 +97,45 @@ struct message *msg_feedback(const struct unit *u, struct order *ord,
       if (!strcmp(paramname, mtype->pnames[i]))
         break;
     }
-    if (i != mtype->nparameters) {
+    if (i == mtype->nparameters) {
+      log_error("invalid parameter %s for message type %s\n", paramname, mtype->name);
+      assert(!"program aborted.");
+      i = -1;
+    }
+    assert(ms->nargs < MAXSIGARGS);
+    ms->slots[ms->nargs++] = i;
+    while (*ic && !isalnum(*ic))
+      ic++;
+  }
+  return ms;
+}
+
+static const msg_signature *get_signature(const message_type * mtype, const char *sig)
+{
+  unsigned int hash = (unsigned int)(((size_t)sig / sizeof(void *) + mtype->key) % MAXSIGHASH);
+  msg_signature *ms;
+
+  for (ms = signatures[hash]; ms; ms = ms->next) {
+    if (ms->sig == sig && ms->mtype == mtype) {
+      return ms;
+    }
+  }
+  ms = make_signature(mtype, sig);
+  ms->next = signatures[hash];
+  signatures[hash] = ms;
+  return ms;
+}
+
+static void
+msg_args(const message_type * mtype, const char *sig, variant args[],
+  va_list marker)
+{
+  const msg_signature *ms = get_signature(mtype, sig);
+  int a;
+
+  for (a = 0; a != ms->nargs; ++a) {
+    int i = ms->slots[a];
+    if (i >= 0) {
       if (mtype->types[i]->vtype == VAR_VOIDPTR) {
         args[i].v = va_arg(marker, void *);
       } else if (mtype->types[i]->vtype == VAR_INT) {
@@ -125,13 +143,39 @@ struct message *msg_feedback(const struct unit *u, struct order *ord,
       } else {
         assert(!"unknown variant type");
       }
-    } else {
-      log_error("invalid parameter %s for message type %s\n", paramname, mtype->name);
-      assert(!"program aborted.");
     }
-    while (*ic && !isalnum(*ic))
-      ic++;
   }
+}
+
+struct message *msg_feedback(const struct unit *u, struct order *ord,
+  const char *name, const char *sig, ...)
+{
+  static const char feedback_sig[] = "unit region command";
+  va_list marker;
+  const message_type *mtype = mt_find(name);
+  const msg_signature *ms;
+  variant args[16];
+  memset(args, 0, sizeof(args));
+
+  if (ord == NULL)
+    ord = u->thisorder;
+
+  if (!mtype) {
+    log_error("trying to create message of unknown type \"%s\"\n", name);
+    return msg_message("missing_feedback", "unit region command name", u,
+      u->region, ord, name);
+  }
+
+  ms = get_signature(mtype, feedback_sig);
+  if (ms->slots[0] >= 0)
+    args[ms->slots[0]].v = (void *)u;
+  if (ms->slots[1] >= 0)
+    args[ms->slots[1]].v = (void *)u->region;
+  if (ms->slots[2] >= 0)
+    args[ms->slots[2]].v = (void *)ord;
+
+  va_start(marker, sig);
+  msg_args(mtype, sig, args, marker);
   va_end(marker);
 
   return msg_create(mtype, args);
@@ -142,8 +186,6 @@ message *msg_message(const char *name, const char *sig, ...)
 {
   va_list marker;
   const message_type *mtype = mt_find(name);
-  char paramname[64];
-  const char *ic = sig;
   variant args[16];
   memset(args, 0, sizeof(args));
 
@@ -156,35 +198,7 @@ message *msg_message(const char *name, const char *sig, ...)
   }
 
   va_start(marker, sig);
-  while (*ic && !isalnum(*ic))
-    ic++;
-  while (*ic) {
-    char *oc = paramname;
-    int i;
-
-    while (isalnum(*ic))
-      *oc++ = *ic++;
-    *oc = '\0';
-
-    for (i = 0; i != mtype->nparameters; ++i) {
-      if (!strcmp(paramname, mtype->pnames[i]))
-        break;
-    }
-    if (i != mtype->nparameters) {
-      if (mtype->types[i]->vtype == VAR_VOIDPTR) {
-        args[i].v = va_arg(marker, void *);
-      } else if (mtype->types[i]->vtype == VAR_INT) {
-        args[i].i = va_arg(marker, int);
-      } else {
-        assert(!"unknown variant type");
-      }
-    } else {
-      log_error("invalid parameter %s for message type %s\n", paramname, mtype->name);
-      assert(!"program aborted.");
-    }
-    while (*ic && !isalnum(*ic))
-      ic++;
-  }
+  msg_args(mtype, sig, args, marker);
   va_end(marker);
 
   return msg_create(mtype, args);
@@ -267,6 +281,37 @@ message * cmistake(const unit * u, struct order *ord, int mno, int mtype)
 
 extern unsigned int new_hashstring(const char *s);
 
+/* list nodes are handed out from blocks and recycled through a free list,
+ * so appending a message to a list does not need a malloc of its own.
+ */
+#define MLIST_BLOCKSIZE 1024
+
+typedef struct mlist_block {
+  struct mlist_block *next;
+  struct mlist nodes[MLIST_BLOCKSIZE];
+} mlist_block;
+
+static mlist_block *mlist_blocks;
+static mlist *mlist_free;
+
+static mlist *mlist_alloc(void)
+{
+  mlist *ml;
+  if (!mlist_free) {
+    mlist_block *block = (mlist_block *)malloc(sizeof(mlist_block));
+    int i;
+    block->next = mlist_blocks;
+    mlist_blocks = block;
+    for (i = 0; i != MLIST_BLOCKSIZE; ++i) {
+      block->nodes[i].next = mlist_free;
+      mlist_free = block->nodes + i;
+    }
+  }
+  ml = mlist_free;
+  mlist_free = ml->next;
+  return ml;
+}
+
 void free_messagelist(message_list * msgs)
 {
   struct mlist **mlistptr = &msgs->begin;
@@ -274,7 +319,8 @@ void free_messagelist(message_list * msgs)
     struct mlist *ml = *mlistptr;
     *mlistptr = ml->next;
     msg_release(ml->msg);
-    free(ml);
+    ml->next = mlist_free;
+    mlist_free = ml;
   }
   free(msgs);
 }
@@ -282,7 +328,7 @@ void free_messagelist(message_list * msgs)
 message *add_message(message_list ** pm, message * m)
 {
   if (!lomem && m != NULL) {
-    struct mlist *mnew = malloc(sizeof(struct mlist));
+    struct mlist *mnew = mlist_alloc();
     if (*pm == NULL) {
       *pm = malloc(sizeof(message_list));
       (*pm)->end = &(*pm)->begin;
@@ -294,3 +340,24 @@ message *add_message(message_list ** pm, message * m)
   }
   return m;
 }
+
+/** releases the list node blocks and signature cache in bulk.
+ * all message lists must have been freed before calling this.
+ */
+void messages_done(void)
+{
+  int i;
+  while (mlist_blocks) {
+    mlist_block *block = mlist_blocks;
+    mlist_blocks = block->next;
+    free(block);
+  }
+  mlist_free = NULL;
+  for (i = 0; i != MAXSIGHASH; ++i) {
+    while (signatures[i]) {
+      msg_signature *ms = signatures[i];
+      signatures[i] = ms->next;
+      free(ms);
+    }
+  }
+}
@@ -37,6 +37,7 @@ extern "C" {
   } message_list;
 
   extern void free_messagelist(message_list * msgs);
+  extern void messages_done(void);
 
   typedef struct msglevel {
     /* used to set specialized msg-levels */
@@ -0,0 +1,98 @@
+#include <platform.h>
+#include "types.h"
+#include "messages.h"
+#include "unit.h"
+
+#include <CuTest.h>
+#include <tests.h>
+
+static const message_type *setup_message_type(void)
+{
+  if (!find_argtype("unit"))
+    register_argtype("unit", NULL, NULL, VAR_VOIDPTR);
+  if (!find_argtype("region"))
+    register_argtype("region", NULL, NULL, VAR_VOIDPTR);
+  if (!find_argtype("order"))
+    register_argtype("order", NULL, NULL, VAR_VOIDPTR);
+  if (!find_argtype("int"))
+    register_argtype("int", NULL, NULL, VAR_INT);
+  return mt_register(mt_new_va("test_signature", "unit:unit", "region:region",
+    "command:order", "value:int", NULL));
+}
+
+static void test_msg_message(CuTest * tc)
+{
+  const message_type *mtype;
+  message *msg;
+  unit *u;
+  int i;
+
+  test_cleanup();
+  mtype = setup_message_type();
+  u = test_create_unit(test_create_faction(0), test_create_region(0, 0, 0));
+  for (i = 0; i != 2; ++i) {
+    /* the second round uses the cached signatures */
+    msg = msg_message("test_signature", "value unit", 42 + i, u);
+    CuAssertPtrEquals(tc, (void *)mtype, (void *)msg->type);
+    CuAssertPtrEquals(tc, u, msg->parameters[0].v);
+    CuAssertPtrEquals(tc, 0, msg->parameters[1].v);
+    CuAssertIntEquals(tc, 42 + i, msg->parameters[3].i);
+    msg_release(msg);
+
+    msg = msg_message("test_signature", "unit value", u, 7);
+    CuAssertPtrEquals(tc, u, msg->parameters[0].v);
+    CuAssertIntEquals(tc, 7, msg->parameters[3].i);
+    msg_release(msg);
+  }
+  test_cleanup();
+}
+
+static void test_msg_feedback(CuTest * tc)
+{
+  message *msg;
+  unit *u;
+
+  test_cleanup();
+  setup_message_type();
+  u = test_create_unit(test_create_faction(0), test_create_region(0, 0, 0));
+  msg = msg_feedback(u, NULL, "test_signature", "value", 5);
+  CuAssertPtrEquals(tc, u, msg->parameters[0].v);
+  CuAssertPtrEquals(tc, u->region, msg->parameters[1].v);
+  CuAssertPtrEquals(tc, u->thisorder, msg->parameters[2].v);
+  CuAssertIntEquals(tc, 5, msg->parameters[3].i);
+  msg_release(msg);
+  test_cleanup();
+}
+
+static void test_add_message(CuTest * tc)
+{
+  message_list *msgs = 0;
+  message *msg;
+  struct mlist *ml;
+  int i;
+
+  test_cleanup();
+  setup_message_type();
+  msg = msg_message("test_signature", "value", 1);
+  for (i = 0; i != 3; ++i) {
+    add_message(&msgs, msg);
+  }
+  CuAssertIntEquals(tc, 4, msg->refcount);
+  for (i = 0, ml = msgs->begin; ml; ml = ml->next, ++i) {
+    CuAssertPtrEquals(tc, msg, ml->msg);
+  }
+  CuAssertIntEquals(tc, 3, i);
+  free_messagelist(msgs);
+  CuAssertIntEquals(tc, 1, msg->refcount);
+  msg_release(msg);
+  test_cleanup();
+}
+
+CuSuite *get_messages_suite(void)
+{
+  CuSuite *suite = CuSuiteNew();
+  SUITE_ADD_TEST(suite, test_msg_message);
+  SUITE_ADD_TEST(suite, test_msg_feedback);
+  SUITE_ADD_TEST(suite, test_add_message);
+  return suite;
+}
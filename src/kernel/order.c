@@ -19,6 +19,7 @@
 
 #include <util/base36.h>
 #include <util/bsdstring.h>
+#include <util/goodies.h>
 #include <util/language.h>
 #include <util/log.h>
 #include <util/parser.h>
@@ -44,7 +45,9 @@ static struct locale_data *locale_array[16];
 static int nlocales = 0;
 
 typedef struct order_data {
+    struct order_data *_next;   /* hash chain of identical-looking orders */
     const char *_str;
+    const char **_tokens;       /* _str split into tokens, see init_order */
 # ifdef LOMEM
     int _refcount:20;
     int _lindex:4;
@@ -55,10 +58,44 @@ typedef struct order_data {
     keyword_t _keyword;
 } order_data;
 
+/* most orders are given verbatim by many units, and again every turn.
+ * identical orders share the same order_data, which is found through
+ * this hash table.
+ */
+#define OMAXHASH 32749
+static order_data *odata_hash[OMAXHASH];
+
+static unsigned int odata_hashkey(keyword_t kwd, int lindex, const char *str)
+{
+    unsigned int key = str ? hashstring(str) : 0;
+    key = key * 31 + (unsigned int)(kwd + 1);
+    key = key * 31 + (unsigned int)lindex;
+    return key % OMAXHASH;
+}
+
+static order_data **odata_find(keyword_t kwd, int lindex, const char *str)
+{
+    order_data **dp = odata_hash + odata_hashkey(kwd, lindex, str);
+    while (*dp) {
+        order_data *data = *dp;
+        if (data->_keyword == kwd && data->_lindex == lindex) {
+            if (str ? (data->_str && strcmp(data->_str, str) == 0) : !data->_str) {
+                break;
+            }
+        }
+        dp = &data->_next;
+    }
+    return dp;
+}
+
 static void release_data(order_data * data)
 {
     if (data) {
         if (--data->_refcount == 0) {
+            order_data **dp = odata_find(data->_keyword, data->_lindex, data->_str);
+            assert(*dp == data);
+            *dp = data->_next;
+            free(data->_tokens);
             free(data);
         }
     }
@@ -186,9 +223,11 @@ static char *mkdata(order_data **pdata, size_t len, keyword_t kwd, int lindex, c
     char *result;
     data = malloc(sizeof(order_data) + len +1);
     result = (char *)(data + 1);
+    data->_next = 0;
     data->_keyword = kwd;
     data->_lindex = lindex;
     data->_refcount = 0;
+    data->_tokens = 0;
     data->_str = 0;
     data->_str = (len > 0) ? result : 0;
     if (str) strcpy(result, str);
@@ -199,7 +238,7 @@ static char *mkdata(order_data **pdata, size_t len, keyword_t kwd, int lindex, c
 static order_data *create_data(keyword_t kwd, const char *sptr, int lindex)
 {
     const char *s = sptr;
-    order_data *data;
+    order_data *data, **dp;
     const struct locale *lang = locale_array[lindex]->lang;
 
     if (kwd != NOKEYWORD)
@@ -240,13 +279,21 @@ static order_data *create_data(keyword_t kwd, const char *sptr, int lindex)
         data = locale_array[lindex]->short_orders[kwd];
         if (data == NULL) {
             mkdata(&data, 0, kwd, lindex, 0);
+            locale_array[lindex]->short_orders[kwd] = data;
             data->_refcount = 1;
         }
         ++data->_refcount;
         return data;
     }
-    mkdata(&data, s ? strlen(s) : 0, kwd, lindex, s);
-    data->_refcount = 1;
+    if (s && *s == 0) {
+        s = NULL;
+    }
+    dp = odata_find(kwd, lindex, s);
+    if (*dp == NULL) {
+        mkdata(dp, s ? strlen(s) : 0, kwd, lindex, s);
+    }
+    data = *dp;
+    ++data->_refcount;
     return data;
 }
 
@@ -561,11 +608,24 @@ void push_order(order ** ordp, order * ord)
     *ordp = ord;
 }
 
+static void release_tokens(void *owner)
+{
+    release_data((order_data *)owner);
+}
+
+/* identical orders share their order_data, so the arguments are split
+ * into tokens only once, the first time any of them is parsed. the
+ * parser holds a reference to the data while it reads the tokens, in
+ * case the order gets freed before it is done.
+ */
 keyword_t init_order(const struct order *ord)
 {
-    char *cmd = 0;
+    order_data *data = ord->data;
 
-    if (ord->data->_str) cmd = _strdup(ord->data->_str);
-    init_tokens_str(cmd, cmd);
-    return ord->data->_keyword;
+    if (!data->_tokens) {
+        data->_tokens = parse_tokens(data->_str);
+    }
+    ++data->_refcount;
+    init_tokens_vec(data->_tokens, release_tokens, data);
+    return data->_keyword;
 }
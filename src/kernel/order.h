@@ -23,8 +23,9 @@ extern "C" {
  * This structure contains one order given by a unit. These used to be
  * stored in string lists, but by storing them in order-structures,
  * it is possible to use reference-counting on them, reduce string copies,
- * and reduce overall memory usage by sharing strings between orders (not
- * implemented yet) saving approx. 50% of all string-related memory.
+ * and reduce overall memory usage by sharing strings between orders.
+ * Identical orders (same keyword, locale and parameters) share their
+ * order_data.
  */
 
   struct order_data;
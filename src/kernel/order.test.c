@@ -99,6 +99,23 @@ static void test_parse_maketemp(CuTest *tc) {
     free_order(ord);
 }
 
+static void test_shared_order_data(CuTest *tc) {
+    char cmd[32];
+    order *ord1, *ord2, *ord3;
+    struct locale * lang = get_or_create_locale("en");
+
+    locale_setstring(lang, "keyword::move", "MOVE");
+    ord1 = parse_order("MOVE NORTH", lang);
+    ord2 = parse_order("MOVE NORTH", lang);
+    ord3 = parse_order("MOVE SOUTH", lang);
+    CuAssertPtrEquals(tc, ord1->data, ord2->data);
+    CuAssertTrue(tc, ord1->data != ord3->data);
+    free_order(ord1);
+    CuAssertStrEquals(tc, "MOVE NORTH", get_command(ord2, cmd, sizeof(cmd)));
+    free_order(ord2);
+    free_order(ord3);
+}
+
 static void test_init_order(CuTest *tc) {
     order *ord;
     struct locale * lang = get_or_create_locale("en");
@@ -129,6 +146,38 @@ static void test_skip_token(CuTest *tc) {
     CuAssertStrEquals(tc, 0, getstrtoken());
 }
 
+static void test_parse_tokens(CuTest *tc) {
+    const char **tokens = parse_tokens("hurr \"durr\" \"\" '' x~y ");
+    CuAssertStrEquals(tc, "hurr", tokens[0]);
+    CuAssertStrEquals(tc, "durr", tokens[1]);
+    CuAssertStrEquals(tc, "", tokens[2]);
+    CuAssertStrEquals(tc, "", tokens[3]);
+    CuAssertStrEquals(tc, "x y", tokens[4]);
+    CuAssertPtrEquals(tc, 0, (void *)tokens[5]);
+    free(tokens);
+    tokens = parse_tokens(0);
+    CuAssertPtrEquals(tc, 0, (void *)tokens[0]);
+    free(tokens);
+}
+
+static void test_init_order_tokens(CuTest *tc) {
+    order *ord1, *ord2;
+    struct locale * lang = get_or_create_locale("en");
+
+    ord1 = create_order(K_MAKETEMP, lang, "hurr durr");
+    ord2 = create_order(K_MAKETEMP, lang, "hurr durr");
+    init_order(ord1);
+    skip_token();
+    CuAssertTrue(tc, !parser_end());
+    /* the tokens outlive the order until the parser moves on */
+    free_order(ord1);
+    free_order(ord2);
+    CuAssertStrEquals(tc, "durr", getstrtoken());
+    CuAssertTrue(tc, parser_end());
+    CuAssertStrEquals(tc, 0, getstrtoken());
+    init_tokens_str(0, 0);
+}
+
 CuSuite *get_order_suite(void)
 {
     CuSuite *suite = CuSuiteNew();
@@ -137,8 +186,11 @@ CuSuite *get_order_suite(void)
     SUITE_ADD_TEST(suite, test_parse_make);
     SUITE_ADD_TEST(suite, test_parse_make_temp);
     SUITE_ADD_TEST(suite, test_parse_maketemp);
+    SUITE_ADD_TEST(suite, test_shared_order_data);
     SUITE_ADD_TEST(suite, test_init_order);
     SUITE_ADD_TEST(suite, test_skip_token);
     SUITE_ADD_TEST(suite, test_getstrtoken);
+    SUITE_ADD_TEST(suite, test_parse_tokens);
+    SUITE_ADD_TEST(suite, test_init_order_tokens);
     return suite;
 }
@@ -26,6 +26,7 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 bool allowed_swim(const region * src, const region * r)
@@ -54,10 +55,27 @@ typedef struct node {
   region *r;
   struct node *prev;
   int distance;
+  int estimate;                 /* distance + heuristic, for path_find */
 } node;
 
 static node *node_garbage;
 
+/* per-region search state, indexed by region::index. an entry is only
+ * valid if its epoch matches the current search, so nothing needs to be
+ * cleared after a search, and the region flags are left alone. */
+typedef struct visit {
+  unsigned int epoch;
+  int distance;
+} visit;
+
+static visit *visits;
+static unsigned int max_visits;
+static unsigned int epoch;
+
+/* open list for path_find, a binary heap ordered by node::estimate */
+static node **open_nodes;
+static int max_open, num_open;
+
 void pathfinder_cleanup(void)
 {
   while (node_garbage) {
@@ -65,6 +83,13 @@ void pathfinder_cleanup(void)
     node_garbage = n->next;
     free(n);
   }
+  free(visits);
+  visits = NULL;
+  max_visits = 0;
+  epoch = 0;
+  free(open_nodes);
+  open_nodes = NULL;
+  max_open = num_open = 0;
 }
 
 static node *new_node(region * r, int distance, node * prev)
@@ -79,6 +104,7 @@ static node *new_node(region * r, int distance, node * prev)
   n->prev = prev;
   n->r = r;
   n->distance = distance;
+  n->estimate = distance;
   return n;
 }
 
@@ -93,12 +119,104 @@ static node *free_node(node * n)
 static void free_nodes(node * root)
 {
   while (root != NULL) {
-    region *r = root->r;
-    freset(r, RF_MARK);
     root = free_node(root);
   }
 }
 
+static void new_search(void)
+{
+  if (++epoch == 0) {
+    /* wrapped around, old entries could look current */
+    if (visits) {
+      memset(visits, 0, sizeof(visit) * max_visits);
+    }
+    epoch = 1;
+  }
+}
+
+/* the returned pointer is only valid until the next call */
+static visit *get_visit(const region * r)
+{
+  unsigned int i = r->index;
+  if (i >= max_visits) {
+    unsigned int size = max_visits ? max_visits : 1024;
+    while (size <= i) {
+      size *= 2;
+    }
+    visits = realloc(visits, sizeof(visit) * size);
+    memset(visits + max_visits, 0, sizeof(visit) * (size - max_visits));
+    max_visits = size;
+  }
+  return visits + i;
+}
+
+/* mark a region as reached at the given distance. returns false if it was
+ * already reached on a path that is at least as short. */
+static bool visit_region(const region * r, int distance)
+{
+  visit *v = get_visit(r);
+  if (v->epoch == epoch && v->distance <= distance) {
+    return false;
+  }
+  v->epoch = epoch;
+  v->distance = distance;
+  return true;
+}
+
+static bool node_before(const node * a, const node * b)
+{
+  if (a->estimate != b->estimate)
+    return a->estimate < b->estimate;
+  /* on ties, prefer nodes that are closer to the target */
+  return a->distance > b->distance;
+}
+
+static void push_open(node * n)
+{
+  int i = num_open++;
+  if (num_open > max_open) {
+    max_open = max_open ? max_open * 2 : 64;
+    open_nodes = realloc(open_nodes, sizeof(node *) * max_open);
+  }
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (!node_before(n, open_nodes[parent]))
+      break;
+    open_nodes[i] = open_nodes[parent];
+    i = parent;
+  }
+  open_nodes[i] = n;
+}
+
+static node *pop_open(void)
+{
+  node *top = open_nodes[0];
+  node *last = open_nodes[--num_open];
+  int i = 0;
+  for (;;) {
+    int child = i * 2 + 1;
+    if (child >= num_open)
+      break;
+    if (child + 1 < num_open
+      && node_before(open_nodes[child + 1], open_nodes[child]))
+      ++child;
+    if (!node_before(open_nodes[child], last))
+      break;
+    open_nodes[i] = open_nodes[child];
+    i = child;
+  }
+  if (num_open > 0)
+    open_nodes[i] = last;
+  return top;
+}
+
+/* lower bound for the number of steps from r to target */
+static int path_estimate(const region * r, const region * target)
+{
+  int dist = distance(r, target);
+  return (dist == INT_MAX) ? 0 : dist;
+}
+
 struct quicklist *regions_in_range(struct region *start, int maxdist,
   bool(*allowed) (const struct region *, const struct region *))
 {
@@ -107,6 +225,7 @@ struct quicklist *regions_in_range(struct region *start, int maxdist,
   node **end = &root->next;
   node *n = root;
 
+  new_search();
   while (n != NULL) {
     region *r = n->r;
     int depth = n->distance + 1;
@@ -118,7 +237,7 @@ struct quicklist *regions_in_range(struct region *start, int maxdist,
       region *rn = rconnect(r, d);
       if (rn == NULL)
         continue;
-      if (fval(rn, RF_MARK))
+      if (get_visit(rn)->epoch == epoch)
         continue;               /* already been there */
       if (allowed && !allowed(r, rn))
         continue;               /* can't go there */
@@ -128,7 +247,7 @@ struct quicklist *regions_in_range(struct region *start, int maxdist,
 
       /* make sure we don't go here again, and put the region into the set for
          further BFS'ing */
-      fset(rn, RF_MARK);
+      visit_region(rn, depth);
       *end = new_node(rn, depth, n);
       end = &(*end)->next;
     }
@@ -139,74 +258,82 @@ struct quicklist *regions_in_range(struct region *start, int maxdist,
   return rlist;
 }
 
-static region **internal_path_find(region * start, const region * target,
-  int maxlen, bool(*allowed) (const region *, const region *))
+/* A* search from start to target, using the hex distance as the heuristic.
+ * if path is not NULL, it receives the regions along the way, starting
+ * with start and ending with target, followed by a NULL. */
+static bool internal_path_find(region * start, const region * target,
+  int maxlen, bool(*allowed) (const region *, const region *),
+  region ** path)
 {
-  static region *path[MAXDEPTH + 2];    /* STATIC_RETURN: used for return, not across calls */
-  direction_t d;
-  node *root = new_node(start, 0, NULL);
-  node **end = &root->next;
-  node *n = root;
+  node *nodes = new_node(start, 0, NULL);
   bool found = false;
-  assert(maxlen <= MAXDEPTH);
-  fset(start, RF_MARK);
 
-  while (n != NULL) {
+  new_search();
+  num_open = 0;
+  visit_region(start, 0);
+  push_open(nodes);
+
+  while (num_open > 0 && !found) {
+    node *n = pop_open();
     region *r = n->r;
     int depth = n->distance + 1;
+    direction_t d;
+
     if (n->distance >= maxlen)
-      break;
+      continue;
+    if (get_visit(r)->distance < n->distance)
+      continue;                 /* a shorter way here was found later */
     for (d = 0; d != MAXDIRECTIONS; ++d) {
       region *rn = rconnect(r, d);
+      int estimate;
+      node *nn;
+
       if (rn == NULL)
         continue;
-      if (fval(rn, RF_MARK))
-        continue;               /* already been there */
       if (!allowed(r, rn))
         continue;               /* can't go there */
       if (rn == target) {
-        int i = depth;
-        path[i + 1] = NULL;
-        path[i] = rn;
-        while (n) {
-          path[--i] = n->r;
-          n = n->prev;
+        if (path) {
+          int i = depth;
+          path[i + 1] = NULL;
+          path[i] = rn;
+          while (n) {
+            path[--i] = n->r;
+            n = n->prev;
+          }
         }
         found = true;
         break;
-      } else {
-        fset(rn, RF_MARK);
-        *end = new_node(rn, depth, n);
-        end = &(*end)->next;
       }
+      if (!visit_region(rn, depth))
+        continue;               /* already been there */
+      estimate = depth + path_estimate(rn, target);
+      if (estimate > maxlen)
+        continue;               /* too far away to still make it */
+      nn = new_node(rn, depth, n);
+      nn->estimate = estimate;
+      nn->next = nodes;
+      nodes = nn;
+      push_open(nn);
     }
-    if (found)
-      break;
-    n = n->next;
   }
-  free_nodes(root);
-  if (found)
-    return path;
-  return NULL;
+  free_nodes(nodes);
+  return found;
 }
 
 bool
 path_exists(region * start, const region * target, int maxlen,
   bool(*allowed) (const region *, const region *))
 {
-  assert((!fval(start, RF_MARK) && !fval(target, RF_MARK))
-    || !"Some Algorithm did not clear its RF_MARKs!");
   if (start == target)
     return true;
-  if (internal_path_find(start, target, maxlen, allowed) != NULL)
-    return true;
-  return false;
+  return internal_path_find(start, target, maxlen, allowed, NULL);
 }
 
 region **path_find(region * start, const region * target, int maxlen,
-  bool(*allowed) (const region *, const region *))
+  bool(*allowed) (const region *, const region *), region ** path)
 {
-  assert((!fval(start, RF_MARK) && !fval(target, RF_MARK))
-    || !"Did you call path_init()?");
-  return internal_path_find(start, target, maxlen, allowed);
+  if (internal_path_find(start, target, maxlen, allowed, path))
+    return path;
+  return NULL;
 }
@@ -27,9 +27,11 @@ extern "C" {
   extern int search[MAXDEPTH][2];
   extern int search_len;
 
+  /* path must have room for maxlen + 2 regions */
   extern struct region **path_find(struct region *start,
     const struct region *target, int maxlen,
-    bool(*allowed) (const struct region *, const struct region *));
+    bool(*allowed) (const struct region *, const struct region *),
+    struct region **path);
   extern bool path_exists(struct region *start, const struct region *target,
     int maxlen, bool(*allowed) (const struct region *,
       const struct region *));
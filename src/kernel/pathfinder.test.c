@@ -0,0 +1,84 @@
+#include <platform.h>
+#include <kernel/config.h>
+#include "pathfinder.h"
+
+#include "region.h"
+#include "terrain.h"
+
+#include <quicklist.h>
+#include <CuTest.h>
+#include <tests.h>
+
+/* two rows of plains from (0,0) to (4,1), with an ocean at (2,0) */
+static void setup_pathfinder(region **start, region **target)
+{
+  const terrain_type *t_plain, *t_ocean;
+  int x, y;
+
+  test_cleanup();
+  t_plain = test_create_terrain("plain", LAND_REGION | WALK_INTO | FLY_INTO);
+  t_ocean = test_create_terrain("ocean", SEA_REGION | SWIM_INTO | FLY_INTO);
+  for (y = 0; y != 2; ++y) {
+    for (x = 0; x != 5; ++x) {
+      test_create_region(x, y, (x == 2 && y == 0) ? t_ocean : t_plain);
+    }
+  }
+  *start = findregion(0, 0);
+  *target = findregion(4, 0);
+}
+
+static void test_path_find(CuTest * tc)
+{
+  region *start, *target;
+  region *path[10];
+  int i;
+
+  setup_pathfinder(&start, &target);
+  CuAssertPtrEquals(tc, path, path_find(start, target, 8, allowed_walk, path));
+  CuAssertPtrEquals(tc, start, path[0]);
+  CuAssertPtrEquals(tc, target, path[5]);
+  CuAssertPtrEquals(tc, NULL, path[6]);
+  for (i = 0; i != 5; ++i) {
+    CuAssertIntEquals(tc, 1, distance(path[i], path[i + 1]));
+    CuAssertTrue(tc, fval(path[i + 1]->terrain, WALK_INTO) != 0);
+  }
+
+  CuAssertPtrEquals(tc, path, path_find(start, target, 8, allowed_fly, path));
+  CuAssertPtrEquals(tc, target, path[4]);
+  CuAssertPtrEquals(tc, NULL, path[5]);
+  test_cleanup();
+}
+
+static void test_path_exists(CuTest * tc)
+{
+  region *start, *target;
+
+  setup_pathfinder(&start, &target);
+  CuAssertTrue(tc, path_exists(start, target, 5, allowed_walk));
+  CuAssertTrue(tc, !path_exists(start, target, 4, allowed_walk));
+  CuAssertTrue(tc, path_exists(start, target, 4, allowed_fly));
+  CuAssertTrue(tc, !path_exists(start, target, 5, allowed_swim));
+  CuAssertIntEquals(tc, 0, fval(start, RF_MARK));
+  test_cleanup();
+}
+
+static void test_regions_in_range(CuTest * tc)
+{
+  region *start, *target;
+  quicklist *rlist;
+
+  setup_pathfinder(&start, &target);
+  rlist = regions_in_range(start, 1, allowed_walk);
+  CuAssertIntEquals(tc, 2, ql_length(rlist));
+  ql_free(rlist);
+  test_cleanup();
+}
+
+CuSuite *get_pathfinder_suite(void)
+{
+  CuSuite *suite = CuSuiteNew();
+  SUITE_ADD_TEST(suite, test_path_find);
+  SUITE_ADD_TEST(suite, test_path_exists);
+  SUITE_ADD_TEST(suite, test_regions_in_range);
+  return suite;
+}
@@ -151,11 +151,31 @@ int set_resvalue(unit * u, const resource_type * rtype, int value)
     return res->value;
 }
 
+/* how much of its slack and reserve unit v lends to u, given the pool
+ * bits of mode. mode has separate bits for the own faction and for
+ * allies, and the default modes have no allied bits, so alliedunit()
+ * is only called when an ally could contribute. every pooled call still
+ * walks all units in the region, so a region where many units draw on
+ * the pool costs time quadratic in the number of units.
+ */
+static int pool_mask(const unit * u, const unit * v, int fmask, int amask,
+    const resource_type * rtype)
+{
+    if (v == u || (urace(v)->ec_flags & GIVEITEM) == 0)
+        return 0;
+    if (v->items == NULL && rtype->uget == NULL)
+        return 0;
+    if (v->faction == u->faction)
+        return fmask;
+    if (amask && alliedunit(v, u->faction, HELP_MONEY))
+        return amask;
+    return 0;
+}
+
 int
 get_pooled(const unit * u, const resource_type * rtype, unsigned int mode,
 int count)
 {
-    const faction *f = u->faction;
     unit *v;
     int use = 0;
     region *r = u->region;
@@ -176,24 +196,16 @@ int count)
             use = slack;
     }
     if (rtype->flags & RTF_POOLED && mode & ~(GET_SLACK | GET_RESERVE)) {
-        for (v = r->units; v && use < count; v = v->next)
-            if (u != v) {
-            int mask;
-
-            if (v->items == NULL && rtype->uget == NULL)
-                continue;
-            if ((urace(v)->ec_flags & GIVEITEM) == 0)
-                continue;
-
-            if (v->faction == f) {
-                mask = (mode >> 3) & (GET_SLACK | GET_RESERVE);
-            }
-            else if (alliedunit(v, f, HELP_MONEY))
-                mask = (mode >> 6) & (GET_SLACK | GET_RESERVE);
-            else
-                continue;
-            use += get_pooled(v, rtype, mask, count - use);
+        int fmask = (mode >> 3) & (GET_SLACK | GET_RESERVE);
+        int amask = (mode >> 6) & (GET_SLACK | GET_RESERVE);
+        if (fmask || amask) {
+            for (v = r->units; v && use < count; v = v->next) {
+                int mask = pool_mask(u, v, fmask, amask, rtype);
+                if (mask) {
+                    use += get_pooled(v, rtype, mask, count - use);
+                }
             }
+        }
     }
     return use;
 }
@@ -201,7 +213,6 @@ int count)
 int
 use_pooled(unit * u, const resource_type * rtype, unsigned int mode, int count)
 {
-    const faction *f = u->faction;
     unit *v;
     int use = count;
     region *r = u->region;
@@ -232,23 +243,16 @@ use_pooled(unit * u, const resource_type * rtype, unsigned int mode, int count)
     }
 
     if (rtype->flags & RTF_POOLED && mode & ~(GET_SLACK | GET_RESERVE)) {
-        for (v = r->units; use > 0 && v != NULL; v = v->next)
-            if (u != v) {
-            int mask;
-            if ((urace(v)->ec_flags & GIVEITEM) == 0)
-                continue;
-            if (v->items == NULL && rtype->uget == NULL)
-                continue;
-
-            if (v->faction == f) {
-                mask = (mode >> 3) & (GET_SLACK | GET_RESERVE);
-            }
-            else if (alliedunit(v, f, HELP_MONEY))
-                mask = (mode >> 6) & (GET_SLACK | GET_RESERVE);
-            else
-                continue;
-            use -= use_pooled(v, rtype, mask, use);
+        int fmask = (mode >> 3) & (GET_SLACK | GET_RESERVE);
+        int amask = (mode >> 6) & (GET_SLACK | GET_RESERVE);
+        if (fmask || amask) {
+            for (v = r->units; use > 0 && v != NULL; v = v->next) {
+                int mask = pool_mask(u, v, fmask, amask, rtype);
+                if (mask) {
+                    use -= use_pooled(v, rtype, mask, use);
+                }
             }
+        }
     }
     return count - use;
 }
@@ -2,6 +2,8 @@
 #include <kernel/types.h>
 
 #include "pool.h"
+#include "ally.h"
+#include "faction.h"
 #include "magic.h"
 #include "unit.h"
 #include "item.h"
@@ -9,6 +11,7 @@
 #include "skill.h"
 
 #include <CuTest.h>
+#include <limits.h>
 #include <tests.h>
 
 void test_change_resource(CuTest * tc)
@@ -38,10 +41,46 @@ void test_change_resource(CuTest * tc)
   }
 }
 
+static void test_pool(CuTest *tc) {
+  unit *u1, *u2, *u3;
+  faction *f;
+  region *r;
+  const resource_type *rtype;
+
+  test_cleanup();
+  test_create_world();
+  rtype = get_resourcetype(R_SILVER);
+  r = findregion(0, 0);
+  f = test_create_faction(0);
+  u1 = test_create_unit(f, r);
+  u2 = test_create_unit(f, r);
+  u3 = test_create_unit(test_create_faction(0), r);
+  ally_add(&u3->faction->allies, f)->status = HELP_MONEY;
+  change_resource(u1, rtype, 10);
+  change_resource(u2, rtype, 20);
+  change_resource(u3, rtype, 40);
+  set_resvalue(u2, rtype, 5);
+
+  CuAssertIntEquals(tc, 25, get_pooled(u1, rtype, GET_DEFAULT, INT_MAX));
+  CuAssertIntEquals(tc, 30, get_pooled(u1, rtype, GET_ALL, INT_MAX));
+  CuAssertIntEquals(tc, 10, get_pooled(u1, rtype, GET_SLACK, INT_MAX));
+  CuAssertIntEquals(tc, 70, get_pooled(u1, rtype, GET_ALL | GET_ALLIED_RESERVE, INT_MAX));
+  CuAssertIntEquals(tc, 40, get_pooled(u3, rtype, GET_DEFAULT, INT_MAX));
+
+  CuAssertIntEquals(tc, 20, use_pooled(u1, rtype, GET_DEFAULT, 20));
+  CuAssertIntEquals(tc, 0, get_resource(u1, rtype));
+  CuAssertIntEquals(tc, 10, get_resource(u2, rtype));
+  CuAssertIntEquals(tc, 5, get_reservation(u2, rtype));
+  CuAssertIntEquals(tc, 40, use_pooled(u1, rtype, GET_ALL | GET_ALLIED_RESERVE, 40));
+  CuAssertIntEquals(tc, 0, get_resource(u2, rtype));
+  CuAssertIntEquals(tc, 10, get_resource(u3, rtype));
+  test_cleanup();
+}
+
 CuSuite *get_pool_suite(void)
 {
   CuSuite *suite = CuSuiteNew();
-/*  SUITE_ADD_TEST(suite, test_pool); */
+  SUITE_ADD_TEST(suite, test_pool);
   SUITE_ADD_TEST(suite, test_change_resource);
   return suite;
 }
@@ -29,12 +29,8 @@
 
 static double ResourceFactor(void)
 {
-  static double value = -1.0;
-  if (value < 0) {
-    const char *str = get_param(global.parameters, "resource.factor");
-    value = str ? atof(str) : 1.0;
-  }
-  return value;
+  static rule_flt rule = RULE_FLT("resource.factor", 1.0F);
+  return rule_get_flt(&rule);
 }
 
 void update_resources(region * r)
@@ -82,10 +78,8 @@ void terraform_resources(region * r)
 {
   int i;
   const terrain_type *terrain = r->terrain;
-  static int terraform_all = -1;
-  if (terraform_all<0) {
-    terraform_all = get_param_int(global.parameters, "rules.terraform.all", 0);
-  }
+  static rule_int rule_terraform_all = RULE_INT("rules.terraform.all", 0);
+  int terraform_all = rule_get_int(&rule_terraform_all);
 
   if (terrain->production == NULL)
     return;
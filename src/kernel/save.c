@@ -81,6 +81,8 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include <stdlib.h>
 #include <ctype.h>
 #include <assert.h>
+#include <limits.h>
+#include <math.h>
 
 #define xisdigit(c)     (((c) >= '0' && (c) <= '9') || (c) == '-')
 
@@ -1444,85 +1446,74 @@ void writefaction(struct gamedata *data, const faction * f)
     write_spellbook(f->spellbook, data->store);
 }
 
-int readgame(const char *filename, int backup)
+static FILE *open_gamedata(const char *path, gamedata *data, storage *store)
 {
-    int i, n, p, nread;
-    faction *f, **fp;
-    region *r;
-    building *b, **bp;
-    ship **shp;
-    unit *u;
-    int rmax = maxregions;
-    char path[MAX_PATH];
-    char name[DISPLAYSIZE];
-    const struct building_type *bt_lighthouse = bt_find("lighthouse");
-    gamedata gdata = { 0 };
-    storage store;
-    FILE *F;
-
-    log_printf(stdout, "- reading game data from %s\n", filename);
-    sprintf(path, "%s/%s", datapath(), filename);
-
-    if (backup) {
-        create_backup(path);
-    }
-
-    F = fopen(path, "rb");
+    FILE *F = fopen(path, "rb");
     if (!F) {
         perror(path);
-        return -1;
+        return NULL;
     }
-    fread(&gdata.version, sizeof(int), 1, F);
-    if (gdata.version >= INTPAK_VERSION) {
+    fread(&data->version, sizeof(int), 1, F);
+    if (data->version >= INTPAK_VERSION) {
         int stream_version;
         fread(&stream_version, sizeof(int), 1, F);
         assert(stream_version == STREAM_VERSION || !"unsupported data format");
     }
-    assert(gdata.version >= MIN_VERSION || !"unsupported data format");
-    assert(gdata.version <= RELEASE_VERSION || !"unsupported data format");
+    assert(data->version >= MIN_VERSION || !"unsupported data format");
+    assert(data->version <= RELEASE_VERSION || !"unsupported data format");
 
-    gdata.encoding = enc_gamedata;
-    binstore_init(&store, F);
-    gdata.store = &store;
-    global.data_version = gdata.version; /* HACK: attribute::read does not have access to gamedata, only storage */
+    data->encoding = enc_gamedata;
+    binstore_init(store, F);
+    data->store = store;
+    global.data_version = data->version; /* HACK: attribute::read does not have access to gamedata, only storage */
+    return F;
+}
+
+/* everything that comes before the regions: global attributes, planes,
+ * alliances and factions */
+static void read_globals(gamedata *data, const char *filename)
+{
+    int i, n, nread;
+    faction **fp;
+    char name[DISPLAYSIZE];
 
-    if (gdata.version >= BUILDNO_VERSION) {
+    if (data->version >= BUILDNO_VERSION) {
         int build;
-        READ_INT(&store, &build);
+        READ_INT(data->store, &build);
         log_debug("data in %s created with build %d.", filename, build);
     }
-    if (gdata.version >= SAVEGAMEID_VERSION) {
+    if (data->version >= SAVEGAMEID_VERSION) {
         int gameid;
 
-        READ_INT(&store, &gameid);
+        READ_INT(data->store, &gameid);
         if (gameid != game_id()) {
             log_warning("game mismatch: datafile contains game %d, but config is for %d\n", gameid, game_id());
             printf("WARNING: invalid game id. any key to continue, Ctrl-C to stop\n");
             getchar();
         }
     }
-    else if (gdata.version >= SAVEXMLNAME_VERSION) {
+    else if (data->version >= SAVEXMLNAME_VERSION) {
         char basefile[32];
-        READ_STR(&store, basefile, sizeof(basefile));
+        READ_STR(data->store, basefile, sizeof(basefile));
     }
-    a_read(&store, &global.attribs, NULL);
-    READ_INT(&store, &turn);
+    a_read(data->store, &global.attribs, NULL);
+    READ_INT(data->store, &turn);
     global.data_turn = turn;
     log_printf(stdout, " - reading turn %d\n", turn);
     rng_init(turn);
     ++global.cookie;
-    READ_INT(&store, &nread);          /* max_unique_id = ignore */
-    READ_INT(&store, &nextborder);
+    READ_INT(data->store, &nread);          /* max_unique_id = ignore */
+    READ_INT(data->store, &nextborder);
 
     /* Planes */
     planes = NULL;
-    READ_INT(&store, &nread);
+    READ_INT(data->store, &nread);
     while (--nread >= 0) {
         int id;
         variant fno;
         plane *pl;
 
-        READ_INT(&store, &id);
+        READ_INT(data->store, &id);
         pl = getplanebyid(id);
 
         if (pl == NULL) {
@@ -1532,20 +1523,20 @@ int readgame(const char *filename, int backup)
             log_warning("the plane with id=%d already exists.\n", id);
         }
         pl->id = id;
-        READ_STR(&store, name, sizeof(name));
+        READ_STR(data->store, name, sizeof(name));
         pl->name = _strdup(name);
-        READ_INT(&store, &pl->minx);
-        READ_INT(&store, &pl->maxx);
-        READ_INT(&store, &pl->miny);
-        READ_INT(&store, &pl->maxy);
-        READ_INT(&store, &pl->flags);
+        READ_INT(data->store, &pl->minx);
+        READ_INT(data->store, &pl->maxx);
+        READ_INT(data->store, &pl->miny);
+        READ_INT(data->store, &pl->maxy);
+        READ_INT(data->store, &pl->flags);
 
         /* read watchers */
-        if (gdata.version < FIX_WATCHERS_VERSION) {
+        if (data->version < FIX_WATCHERS_VERSION) {
             char rname[64];
             /* before this version, watcher storage was pretty broken. we are incompatible and don't read them */
             for (;;) {
-                READ_TOK(&store, rname, sizeof(rname));
+                READ_TOK(data->store, rname, sizeof(rname));
                 if (strcmp(rname, "end") == 0) {
                     break;                /* this is most likely the end of the list */
                 }
@@ -1556,35 +1547,35 @@ int readgame(const char *filename, int backup)
             }
         }
         else {
-            fno = read_faction_reference(&store);
+            fno = read_faction_reference(data->store);
             while (fno.i) {
                 watcher *w = (watcher *)malloc(sizeof(watcher));
                 ur_add(fno, &w->faction, resolve_faction);
-                READ_INT(&store, &n);
+                READ_INT(data->store, &n);
                 w->mode = (unsigned char)n;
                 w->next = pl->watchers;
                 pl->watchers = w;
-                fno = read_faction_reference(&store);
+                fno = read_faction_reference(data->store);
             }
         }
-        a_read(&store, &pl->attribs, pl);
+        a_read(data->store, &pl->attribs, pl);
         if (pl->id != 1094969858) { // Regatta
             addlist(&planes, pl);
         }
     }
 
     /* Read factions */
-    if (gdata.version >= ALLIANCES_VERSION) {
-        read_alliances(&store);
+    if (data->version >= ALLIANCES_VERSION) {
+        read_alliances(data->store);
     }
-    READ_INT(&store, &nread);
+    READ_INT(data->store, &nread);
     log_printf(stdout, " - Einzulesende Parteien: %d\n", nread);
     fp = &factions;
     while (*fp)
         fp = &(*fp)->next;
 
     while (--nread >= 0) {
-        faction *f = readfaction(&gdata);
+        faction *f = readfaction(data);
 
         *fp = f;
         fp = &f->next;
@@ -1593,141 +1584,189 @@ int readgame(const char *filename, int backup)
     *fp = 0;
 
     /* ignore the obsolete list of "used" faction ids */
-    if (gdata.version < STORAGE_VERSION) {
-        READ_INT(&store, &i);
+    if (data->version < STORAGE_VERSION) {
+        READ_INT(data->store, &i);
         while (i--) {
-            READ_INT(&store, &n);
+            READ_INT(data->store, &n);
         }
     }
 
-    /* Regionen */
+}
 
-    READ_INT(&store, &nread);
-    assert(nread < MAXREGIONS);
-    if (rmax < 0) {
-        rmax = nread;
-    }
-    log_printf(stdout, " - Einzulesende Regionen: %d/%d\r", rmax, nread);
-    while (--nread >= 0) {
-        unit **up;
-        int x, y;
-        READ_INT(&store, &x);
-        READ_INT(&store, &y);
+static region *read_region_block(gamedata *data, int x, int y,
+    const struct building_type *bt_lighthouse)
+{
+    int p, n;
+    building *b, **bp;
+    ship **shp;
+    unit **up;
+    char name[DISPLAYSIZE];
+    region *r = readregion(data, x, y);
 
-        if ((nread & 0x3FF) == 0) {     /* das spart extrem Zeit */
-            log_printf(stdout, " - Einzulesende Regionen: %d/%d * %d,%d    \r", rmax, nread, x, y);
+    /* Burgen */
+    READ_INT(data->store, &p);
+    bp = &r->buildings;
+
+    while (--p >= 0) {
+
+        b = (building *)calloc(1, sizeof(building));
+        READ_INT(data->store, &b->no);
+        *bp = b;
+        bp = &b->next;
+        bhash(b);
+        READ_STR(data->store, name, sizeof(name));
+        b->name = _strdup(name);
+        if (lomem) {
+            READ_STR(data->store, NULL, 0);
         }
-        --rmax;
+        else {
+            READ_STR(data->store, name, sizeof(name));
+            b->display = _strdup(name);
+        }
+        READ_INT(data->store, &b->size);
+        READ_STR(data->store, name, sizeof(name));
+        b->type = bt_find(name);
+        b->region = r;
+        a_read(data->store, &b->attribs, b);
+        if (b->type == bt_lighthouse) {
+            r->flags |= RF_LIGHTHOUSE;
+        }
+    }
+    /* Schiffe */
 
-        r = readregion(&gdata, x, y);
+    READ_INT(data->store, &p);
+    shp = &r->ships;
+
+    while (--p >= 0) {
+        ship *sh = (ship *)calloc(1, sizeof(ship));
+        sh->region = r;
+        READ_INT(data->store, &sh->no);
+        *shp = sh;
+        shp = &sh->next;
+        shash(sh);
+        READ_STR(data->store, name, sizeof(name));
+        sh->name = _strdup(name);
+        if (lomem) {
+            READ_STR(data->store, NULL, 0);
+        }
+        else {
+            READ_STR(data->store, name, sizeof(name));
+            sh->display = _strdup(name);
+        }
+        READ_STR(data->store, name, sizeof(name));
+        sh->type = st_find(name);
+        if (sh->type == NULL) {
+            /* old datafiles */
+            sh->type = st_find((const char *)locale_string(default_locale, name));
+        }
+        assert(sh->type || !"ship_type not registered!");
 
-        /* Burgen */
-        READ_INT(&store, &p);
-        bp = &r->buildings;
+        READ_INT(data->store, &sh->size);
+        READ_INT(data->store, &sh->damage);
+        if (data->version >= FOSS_VERSION) {
+            READ_INT(data->store, &sh->flags);
+        }
 
-        while (--p >= 0) {
+        /* Attribute rekursiv einlesen */
 
-            b = (building *)calloc(1, sizeof(building));
-            READ_INT(&store, &b->no);
-            *bp = b;
-            bp = &b->next;
-            bhash(b);
-            READ_STR(&store, name, sizeof(name));
-            b->name = _strdup(name);
-            if (lomem) {
-                READ_STR(gdata.store, NULL, 0);
-            }
-            else {
-                READ_STR(&store, name, sizeof(name));
-                b->display = _strdup(name);
-            }
-            READ_INT(&store, &b->size);
-            READ_STR(&store, name, sizeof(name));
-            b->type = bt_find(name);
-            b->region = r;
-            a_read(&store, &b->attribs, b);
-            if (b->type == bt_lighthouse) {
-                r->flags |= RF_LIGHTHOUSE;
-            }
+        READ_INT(data->store, &n);
+        sh->coast = (direction_t)n;
+        if (sh->type->flags & SFL_NOCOAST) {
+            sh->coast = NODIRECTION;
         }
-        /* Schiffe */
+        a_read(data->store, &sh->attribs, sh);
+    }
 
-        READ_INT(&store, &p);
-        shp = &r->ships;
+    *shp = 0;
 
-        while (--p >= 0) {
-            ship *sh = (ship *)calloc(1, sizeof(ship));
-            sh->region = r;
-            READ_INT(&store, &sh->no);
-            *shp = sh;
-            shp = &sh->next;
-            shash(sh);
-            READ_STR(&store, name, sizeof(name));
-            sh->name = _strdup(name);
-            if (lomem) {
-                READ_STR(&store, NULL, 0);
+    /* Einheiten */
+
+    READ_INT(data->store, &p);
+    up = &r->units;
+
+    while (--p >= 0) {
+        unit *u = read_unit(data);
+        sc_mage *mage;
+
+        assert(u->region == NULL);
+        u->region = r;
+        *up = u;
+        up = &u->next;
+
+        update_interval(u->faction, u->region);
+        mage = get_mage(u);
+        if (mage) {
+            faction *f = u->faction;
+            int skl = effskill(u, SK_MAGIC);
+            if (!is_monsters(f) && f->magiegebiet == M_GRAY) {
+                log_error("faction %s had magic=gray, fixing (%s)\n", factionname(f), magic_school[mage->magietyp]);
+                f->magiegebiet = mage->magietyp;
             }
-            else {
-                READ_STR(&store, name, sizeof(name));
-                sh->display = _strdup(name);
+            if (f->max_spelllevel < skl) {
+                f->max_spelllevel = skl;
             }
-            READ_STR(&store, name, sizeof(name));
-            sh->type = st_find(name);
-            if (sh->type == NULL) {
-                /* old datafiles */
-                sh->type = st_find((const char *)locale_string(default_locale, name));
+            if (mage->spellcount < 0) {
+                mage->spellcount = 0;
             }
-            assert(sh->type || !"ship_type not registered!");
+        }
+    }
+    return r;
+}
 
-            READ_INT(&store, &sh->size);
-            READ_INT(&store, &sh->damage);
-            if (gdata.version >= FOSS_VERSION) {
-                READ_INT(&store, &sh->flags);
-            }
+static void update_lighthouses(void)
+{
+    region *r;
+    for (r = regions; r; r = r->next) {
+        if (r->flags & RF_LIGHTHOUSE) {
+            building *b;
+            for (b = r->buildings; b; b = b->next)
+                update_lighthouse(b);
+        }
+    }
+}
 
-            /* Attribute rekursiv einlesen */
+int readgame(const char *filename, int backup)
+{
+    int nread;
+    faction *f;
+    unit *u;
+    int rmax = maxregions;
+    char path[MAX_PATH];
+    const struct building_type *bt_lighthouse = bt_find("lighthouse");
+    gamedata gdata = { 0 };
+    storage store;
 
-            READ_INT(&store, &n);
-            sh->coast = (direction_t)n;
-            if (sh->type->flags & SFL_NOCOAST) {
-                sh->coast = NODIRECTION;
-            }
-            a_read(&store, &sh->attribs, sh);
-        }
+    log_printf(stdout, "- reading game data from %s\n", filename);
+    sprintf(path, "%s/%s", datapath(), filename);
 
-        *shp = 0;
+    if (backup) {
+        create_backup(path);
+    }
 
-        /* Einheiten */
+    if (!open_gamedata(path, &gdata, &store)) {
+        return -1;
+    }
+    read_globals(&gdata, filename);
 
-        READ_INT(&store, &p);
-        up = &r->units;
+    /* Regionen */
 
-        while (--p >= 0) {
-            unit *u = read_unit(&gdata);
-            sc_mage *mage;
-
-            assert(u->region == NULL);
-            u->region = r;
-            *up = u;
-            up = &u->next;
-
-            update_interval(u->faction, u->region);
-            mage = get_mage(u);
-            if (mage) {
-                faction *f = u->faction;
-                int skl = effskill(u, SK_MAGIC);
-                if (!is_monsters(f) && f->magiegebiet == M_GRAY) {
-                    log_error("faction %s had magic=gray, fixing (%s)\n", factionname(f), magic_school[mage->magietyp]);
-                    f->magiegebiet = mage->magietyp;
-                }
-                if (f->max_spelllevel < skl) {
-                    f->max_spelllevel = skl;
-                }
-                if (mage->spellcount < 0) {
-                    mage->spellcount = 0;
-                }
-            }
+    READ_INT(&store, &nread);
+    assert(nread < MAXREGIONS);
+    if (rmax < 0) {
+        rmax = nread;
+    }
+    log_printf(stdout, " - Einzulesende Regionen: %d/%d\r", rmax, nread);
+    while (--nread >= 0) {
+        int x, y;
+        READ_INT(&store, &x);
+        READ_INT(&store, &y);
+
+        if ((nread & 0x3FF) == 0) {     /* das spart extrem Zeit */
+            log_printf(stdout, " - Einzulesende Regionen: %d/%d * %d,%d    \r", rmax, nread, x, y);
         }
+        --rmax;
+
+        read_region_block(&gdata, x, y, bt_lighthouse);
     }
     log_printf(stdout, "\n");
     read_borders(&store);
@@ -1739,13 +1778,7 @@ int readgame(const char *filename, int backup)
     resolve();
 
     log_printf(stdout, "updating area information for lighthouses.\n");
-    for (r = regions; r; r = r->next) {
-        if (r->flags & RF_LIGHTHOUSE) {
-            building *b;
-            for (b = r->buildings; b; b = b->next)
-                update_lighthouse(b);
-        }
-    }
+    update_lighthouses();
     log_printf(stdout, "marking factions as alive.\n");
     for (f = factions; f; f = f->next) {
         if (f->flags & FFL_NPC) {
@@ -1774,6 +1807,264 @@ int readgame(const char *filename, int backup)
     return 0;
 }
 
+/* file positions in the region index are stored as two ints, low half
+ * first, so that the index also works for datafiles larger than 2 GB.
+ * a negative position marks a file that was written without an index.
+ */
+#define INDEX_HEADER (2 * sizeof(int))  /* version and stream version */
+#define INDEX_ENTRY (5 * sizeof(int))   /* x, y, offset (2 ints), size */
+
+static void split_position(long pos, int *lo, int *hi)
+{
+    long long p = pos;
+    *lo = (int)(p & 0xffffffffLL);
+    *hi = (int)(p >> 32);
+}
+
+static long join_position(int lo, int hi)
+{
+    long long p;
+    if (hi < 0) {
+        return -1;
+    }
+    p = ((long long)hi << 32) | (unsigned int)lo;
+    return (p > LONG_MAX) ? -1 : (long)p;
+}
+
+static int read_index_entries(storage *store, long start, long end,
+    region_index **result)
+{
+    region_index *index;
+    int i, n;
+
+    if (READ_INT(store, &n) != 0 || n < 0
+        || (unsigned long)n > (unsigned long)(end - start - sizeof(int)) / INDEX_ENTRY) {
+        return -1;
+    }
+    index = (region_index *)malloc(sizeof(region_index) * (n + 1));
+    for (i = 0; i != n; ++i) {
+        region_index *ri = index + i;
+        int lo, hi;
+        if (READ_INT(store, &ri->x) != 0 || READ_INT(store, &ri->y) != 0
+            || READ_INT(store, &lo) != 0 || READ_INT(store, &hi) != 0
+            || READ_INT(store, &ri->size) != 0) {
+            break;
+        }
+        ri->offset = join_position(lo, hi);
+        if (ri->offset < (long)INDEX_HEADER || ri->size < 0
+            || ri->size > start - ri->offset) {
+            break;
+        }
+    }
+    if (i != n) {
+        free(index);
+        return -1;
+    }
+    *result = index;
+    return n;
+}
+
+/** reads the region index of a datafile written by writegame().
+ * returns the number of regions, or -1 if the file is from a version
+ * that did not have an index yet, was written without one, or is
+ * truncated.
+ */
+int read_region_index(const char *filename, region_index **result)
+{
+    char path[MAX_PATH];
+    storage store;
+    FILE *F;
+    int n, version, tail[2];
+    long pos, end;
+
+    sprintf(path, "%s/%s", datapath(), filename);
+    F = fopen(path, "rb");
+    if (!F) {
+        perror(path);
+        return -1;
+    }
+    if (fread(&version, sizeof(int), 1, F) != 1
+        || version < REGIONINDEX_VERSION || version > RELEASE_VERSION
+        || fseek(F, 0, SEEK_END) != 0 || (end = ftell(F)) < 0
+        || end < (long)(INDEX_HEADER + sizeof(tail))) {
+        fclose(F);
+        return -1;
+    }
+    end -= sizeof(tail);
+    if (fseek(F, end, SEEK_SET) != 0 || fread(tail, sizeof(int), 2, F) != 2) {
+        fclose(F);
+        return -1;
+    }
+    pos = join_position(tail[0], tail[1]);
+    if (pos < (long)INDEX_HEADER || pos > end - (long)sizeof(int)
+        || fseek(F, pos, SEEK_SET) != 0) {
+        fclose(F);
+        return -1;
+    }
+    binstore_init(&store, F);
+    n = read_index_entries(&store, pos, end, result);
+    binstore_done(&store);
+    return n;
+}
+
+/* partial loading: opengame() reads everything but the regions and
+ * keeps the file open, readgame_region() decodes single region blocks
+ * through the region index when they are first needed.
+ * connections are read by opengame(), and attached once both of their
+ * regions are loaded. references to objects in other regions are kept
+ * pending and resolved when that region is loaded, closegame() drops
+ * the ones that are still unresolved. since units in regions that are
+ * not loaded are unknown, every faction counts as alive.
+ */
+static struct {
+    gamedata data;
+    storage store;
+    FILE *F;
+    region_index *index;
+    int nregions;
+    const struct building_type *bt_lighthouse;
+    int lighthouse_range;       /* largest range of a loaded lighthouse */
+} lazy;
+
+static int cmp_region_index(const void *a, const void *b)
+{
+    const region_index *ra = (const region_index *)a;
+    const region_index *rb = (const region_index *)b;
+    if (ra->x != rb->x) {
+        return (ra->x < rb->x) ? -1 : 1;
+    }
+    return (ra->y < rb->y) ? -1 : (ra->y > rb->y);
+}
+
+int opengame(const char *filename)
+{
+    char path[MAX_PATH];
+    int i, n, nread;
+    long end;
+    faction *f;
+
+    closegame();
+    n = read_region_index(filename, &lazy.index);
+    if (n < 0) {
+        log_error("%s has no region index, it must be loaded with readgame\n", filename);
+        return -1;
+    }
+    lazy.nregions = n;
+    qsort(lazy.index, n, sizeof(region_index), cmp_region_index);
+
+    log_printf(stdout, "- opening game data in %s\n", filename);
+    sprintf(path, "%s/%s", datapath(), filename);
+    lazy.F = open_gamedata(path, &lazy.data, &lazy.store);
+    if (!lazy.F) {
+        free(lazy.index);
+        lazy.index = NULL;
+        return -1;
+    }
+    read_globals(&lazy.data, filename);
+    for (f = factions; f; f = f->next) {
+        f->alive = 1;
+    }
+
+    /* the connections follow the last region block */
+    end = -1;
+    if (READ_INT(&lazy.store, &nread) == 0 && nread == n) {
+        end = ftell(lazy.F);
+        for (i = 0; i != n; ++i) {
+            if (lazy.index[i].offset + lazy.index[i].size > end) {
+                end = lazy.index[i].offset + lazy.index[i].size;
+            }
+        }
+    }
+    if (end < 0 || fseek(lazy.F, end, SEEK_SET) != 0) {
+        log_error("%s: the region index does not match the datafile\n", filename);
+        closegame();
+        return -1;
+    }
+    read_borders_deferred(&lazy.store);
+    resolve_pending();
+    lazy.bt_lighthouse = bt_find("lighthouse");
+    lazy.lighthouse_range = 0;
+    return 0;
+}
+
+/* the lighthouses of a newly loaded region mark the sea around them,
+ * and if it is a sea region, the lighthouses near it that are already
+ * loaded mark it. this is cheaper than update_lighthouses() for every
+ * region that gets loaded. */
+static void update_lighthouses_near(region * r)
+{
+    building *b;
+    int x, y, d;
+
+    if (r->flags & RF_LIGHTHOUSE) {
+        for (b = r->buildings; b; b = b->next) {
+            if (b->type == lazy.bt_lighthouse && b->size > 0) {
+                d = (int)log10(b->size) + 1;
+                if (d > lazy.lighthouse_range) {
+                    lazy.lighthouse_range = d;
+                }
+            }
+            update_lighthouse(b);
+        }
+    }
+    if (!fval(r->terrain, SEA_REGION)) {
+        return;
+    }
+    d = lazy.lighthouse_range;
+    for (x = -d; x <= d; ++x) {
+        for (y = -d; y <= d; ++y) {
+            int px = r->x + x, py = r->y + y;
+            region *r2;
+
+            pnormalize(&px, &py, rplane(r));
+            r2 = findregion(px, py);
+            if (r2 && r2 != r && (r2->flags & RF_LIGHTHOUSE)) {
+                for (b = r2->buildings; b; b = b->next) {
+                    update_lighthouse(b);
+                }
+            }
+        }
+    }
+}
+
+region *readgame_region(int x, int y)
+{
+    region_index key, *ri;
+    region *r = findregion(x, y);
+
+    if (r || !lazy.F) {
+        return r;
+    }
+    key.x = x;
+    key.y = y;
+    ri = (region_index *)bsearch(&key, lazy.index, lazy.nregions, sizeof(region_index), cmp_region_index);
+    if (!ri) {
+        return NULL;
+    }
+    if (fseek(lazy.F, ri->offset, SEEK_SET) != 0
+        || READ_INT(&lazy.store, &x) != 0 || READ_INT(&lazy.store, &y) != 0) {
+        log_error("could not read region %d,%d from the datafile\n", key.x, key.y);
+        return NULL;
+    }
+    r = read_region_block(&lazy.data, x, y, lazy.bt_lighthouse);
+    attach_borders();
+    resolve_pending();
+    update_lighthouses_near(r);
+    return r;
+}
+
+void closegame(void)
+{
+    if (lazy.F) {
+        binstore_done(&lazy.store);
+        lazy.F = NULL;
+        resolve();
+    }
+    free(lazy.index);
+    lazy.index = NULL;
+    lazy.nregions = 0;
+}
+
 static void clear_monster_orders(void)
 {
     faction *f = get_monsters();
@@ -1798,6 +2089,10 @@ int writegame(const char *filename)
     gamedata gdata;
     storage store;
     FILE *F;
+    region_index *index;
+    int i, nregions, tail[2];
+    long pos;
+    bool indexed = true;
 
     clear_monster_orders();
     sprintf(path, "%s/%s", datapath(), filename);
@@ -1884,18 +2179,25 @@ int writegame(const char *filename)
 
     /* Write regions */
 
-    n = listlen(regions);
+    n = nregions = listlen(regions);
     WRITE_INT(&store, n);
     WRITE_SECTION(&store);
     log_printf(stdout, " - Schreibe Regionen: %d  \r", n);
 
-    for (r = regions; r; r = r->next, --n) {
+    index = (region_index *)malloc(sizeof(region_index) * (nregions + 1));
+    for (i = 0, r = regions; r; r = r->next, --n, ++i) {
         /* plus leerzeile */
         if ((n % 1024) == 0) {      /* das spart extrem Zeit */
             log_printf(stdout, " - Schreibe Regionen: %d  \r", n);
             fflush(stdout);
         }
         WRITE_SECTION(&store);
+        index[i].x = r->x;
+        index[i].y = r->y;
+        index[i].offset = ftell(F);
+        if (index[i].offset < 0) {
+            indexed = false;
+        }
         WRITE_INT(&store, r->x);
         WRITE_INT(&store, r->y);
         writeregion(&gdata, r);
@@ -1938,9 +2240,44 @@ int writegame(const char *filename)
         }
     }
     WRITE_SECTION(&store);
+    pos = ftell(F);
+    if (pos < 0) {
+        indexed = false;
+    }
+    for (i = 0; indexed && i != nregions; ++i) {
+        long size = ((i + 1 < nregions) ? index[i + 1].offset : pos) - index[i].offset;
+        if (size > INT_MAX) {
+            indexed = false;
+        }
+        index[i].size = (int)size;
+    }
     write_borders(&store);
     WRITE_SECTION(&store);
 
+    /* the region index goes last, followed by its position in the file,
+     * so tools can find a region without decoding the whole world.
+     * if a position could not be determined, only the marker is written. */
+    pos = indexed ? ftell(F) : -1;
+    if (pos >= 0) {
+        WRITE_INT(&store, nregions);
+        for (i = 0; i != nregions; ++i) {
+            int lo, hi;
+            WRITE_INT(&store, index[i].x);
+            WRITE_INT(&store, index[i].y);
+            split_position(index[i].offset, &lo, &hi);
+            WRITE_INT(&store, lo);
+            WRITE_INT(&store, hi);
+            WRITE_INT(&store, index[i].size);
+        }
+        WRITE_SECTION(&store);
+    }
+    else {
+        log_warning("writing %s without a region index\n", filename);
+    }
+    split_position(pos, tail, tail + 1);
+    fwrite(tail, sizeof(int), 2, F);
+    free(index);
+
     binstore_done(&store);
 
     log_printf(stdout, "\nOk.\n");
@@ -37,6 +37,18 @@ extern "C" {
   int readgame(const char *filename, int backup);
   int writegame(const char *filename);
 
+  typedef struct region_index {
+    int x, y;
+    long offset;                /* file position of the region block */
+    int size;                   /* size of the block, including units */
+  } region_index;
+
+  int read_region_index(const char *filename, struct region_index **result);
+
+  int opengame(const char *filename);
+  struct region *readgame_region(int x, int y);
+  void closegame(void);
+
 /* Versionsnderungen: */
   extern int data_version;
   extern int enc_gamedata;
@@ -2,11 +2,23 @@
 #include <kernel/config.h>
 
 #include "save.h"
+#include "building.h"
+#include "connection.h"
+#include "faction.h"
+#include "magic.h"
+#include "region.h"
+#include "terrain.h"
+#include "unit.h"
 #include "version.h"
+#include <util/attrib.h>
 #include <CuTest.h>
 #include <tests.h>
 
+#include <storage.h>
+#include <binarystore.h>
+
 #include <stdio.h>
+#include <stdlib.h>
 
 static void test_readwrite_data(CuTest * tc)
 {
@@ -19,9 +31,219 @@ static void test_readwrite_data(CuTest * tc)
     CuAssertIntEquals(tc, 0, remove(path));
 }
 
+static void test_region_index(CuTest * tc)
+{
+    const char *filename = "test.dat";
+    char path[MAX_PATH];
+    region_index *index;
+    storage store;
+    FILE *F;
+    int i, x, y;
+
+    test_cleanup();
+    test_create_region(0, 0, 0);
+    test_create_region(1, 2, 0);
+    sprintf(path, "%s/%s", datapath(), filename);
+    CuAssertIntEquals(tc, 0, writegame(filename));
+    CuAssertIntEquals(tc, 2, read_region_index(filename, &index));
+    CuAssertIntEquals(tc, 1, index[1].x);
+    CuAssertIntEquals(tc, 2, index[1].y);
+    F = fopen(path, "rb");
+    binstore_init(&store, F);
+    for (i = 0; i != 2; ++i) {
+        CuAssertTrue(tc, index[i].size > 0);
+        fseek(F, index[i].offset, SEEK_SET);
+        READ_INT(&store, &x);
+        READ_INT(&store, &y);
+        CuAssertIntEquals(tc, index[i].x, x);
+        CuAssertIntEquals(tc, index[i].y, y);
+    }
+    CuAssertIntEquals(tc, index[0].offset + index[0].size, index[1].offset);
+    binstore_done(&store);
+    free(index);
+    free_gamedata();
+    CuAssertPtrEquals(tc, 0, findregion(1, 2));
+    CuAssertIntEquals(tc, 0, readgame(filename, 0));
+    CuAssertPtrNotNull(tc, findregion(1, 2));
+    CuAssertIntEquals(tc, 0, remove(path));
+    test_cleanup();
+}
+
+static void truncate_file(const char *path, long size)
+{
+    FILE *F = fopen(path, "rb");
+    char *buf = (char *)malloc(size);
+    size_t len = fread(buf, 1, size, F);
+    fclose(F);
+    F = fopen(path, "wb");
+    fwrite(buf, 1, len, F);
+    fclose(F);
+    free(buf);
+}
+
+static void test_region_index_truncated(CuTest * tc)
+{
+    const char *filename = "test.dat";
+    char path[MAX_PATH];
+    region_index *index = 0;
+    FILE *F;
+    long size;
+
+    test_cleanup();
+    test_create_region(0, 0, 0);
+    test_create_region(1, 2, 0);
+    sprintf(path, "%s/%s", datapath(), filename);
+    CuAssertIntEquals(tc, 0, writegame(filename));
+    F = fopen(path, "rb");
+    fseek(F, 0, SEEK_END);
+    size = ftell(F);
+    fclose(F);
+
+    /* the trailer is cut off, so the index position is garbage */
+    truncate_file(path, size - sizeof(int));
+    CuAssertIntEquals(tc, -1, read_region_index(filename, &index));
+    truncate_file(path, size / 2);
+    CuAssertIntEquals(tc, -1, read_region_index(filename, &index));
+    truncate_file(path, sizeof(int));
+    CuAssertIntEquals(tc, -1, read_region_index(filename, &index));
+    CuAssertPtrEquals(tc, 0, index);
+    CuAssertIntEquals(tc, 0, remove(path));
+    test_cleanup();
+}
+
+static void test_readgame_region(CuTest * tc)
+{
+    const char *filename = "test.dat";
+    char path[MAX_PATH];
+    faction *f;
+    region *r;
+    int fno;
+
+    test_cleanup();
+    f = test_create_faction(0);
+    fno = f->no;
+    test_create_region(0, 0, 0);
+    test_create_unit(f, test_create_region(1, 2, 0));
+    sprintf(path, "%s/%s", datapath(), filename);
+    CuAssertIntEquals(tc, 0, writegame(filename));
+    free_gamedata();
+
+    CuAssertIntEquals(tc, 0, opengame(filename));
+    f = findfaction(fno);
+    CuAssertPtrNotNull(tc, f);
+    CuAssertPtrEquals(tc, 0, regions);
+    CuAssertPtrEquals(tc, 0, readgame_region(5, 5));
+    r = readgame_region(1, 2);
+    CuAssertPtrNotNull(tc, r);
+    CuAssertPtrEquals(tc, r, regions);
+    CuAssertPtrEquals(tc, r, readgame_region(1, 2));
+    CuAssertPtrEquals(tc, 0, findregion(0, 0));
+    CuAssertPtrNotNull(tc, r->units);
+    CuAssertPtrEquals(tc, f, r->units->faction);
+    closegame();
+    CuAssertIntEquals(tc, 0, remove(path));
+    test_cleanup();
+}
+
+static void test_readgame_region_links(CuTest * tc)
+{
+    const char *filename = "test.dat";
+    char path[MAX_PATH];
+    faction *f;
+    region *r1, *r2;
+    unit *mage, *familiar;
+    connection *b;
+    int fno, mno, uno;
+
+    test_cleanup();
+    r1 = test_create_region(0, 0, 0);
+    r2 = test_create_region(1, 0, 0);
+    new_border(&bt_road, r1, r2);
+    f = test_create_faction(0);
+    mage = test_create_unit(f, r1);
+    familiar = test_create_unit(f, r2);
+    a_add(&mage->attribs, a_new(&at_familiar))->data.v = familiar;
+    a_add(&familiar->attribs, a_new(&at_familiarmage))->data.v = mage;
+    fno = f->no;
+    mno = mage->no;
+    uno = familiar->no;
+    sprintf(path, "%s/%s", datapath(), filename);
+    CuAssertIntEquals(tc, 0, writegame(filename));
+    free_gamedata();
+
+    CuAssertIntEquals(tc, 0, opengame(filename));
+    f = findfaction(fno);
+    CuAssertPtrNotNull(tc, f);
+    CuAssertTrue(tc, f->alive);
+
+    /* the familiar is in a region that is not loaded yet */
+    r1 = readgame_region(0, 0);
+    mage = findunit(mno);
+    CuAssertPtrNotNull(tc, mage);
+    CuAssertPtrEquals(tc, 0, findunit(uno));
+    CuAssertPtrEquals(tc, 0, a_find(mage->attribs, &at_familiar)->data.v);
+
+    r2 = readgame_region(1, 0);
+    familiar = findunit(uno);
+    CuAssertPtrNotNull(tc, familiar);
+    CuAssertPtrEquals(tc, familiar, get_familiar(mage));
+    CuAssertPtrEquals(tc, mage, get_familiar_mage(familiar));
+    b = get_borders(r1, r2);
+    CuAssertPtrNotNull(tc, b);
+    CuAssertPtrEquals(tc, &bt_road, b->type);
+    CuAssertPtrEquals(tc, 0, b->next);
+
+    closegame();
+    CuAssertIntEquals(tc, 0, remove(path));
+    test_cleanup();
+}
+
+static void test_readgame_region_lighthouse(CuTest * tc)
+{
+    const char *filename = "test.dat";
+    char path[MAX_PATH];
+    region *r, *sea[2];
+    building *b;
+    int x[2], y[2], i;
+
+    test_cleanup();
+    test_create_world();
+    r = findregion(0, 0);
+    b = test_create_building(r, test_create_buildingtype("lighthouse"));
+    b->size = 10;
+    sea[0] = r_connect(r, D_WEST);
+    sea[1] = r_connect(r, D_NORTHWEST);
+    for (i = 0; i != 2; ++i) {
+        x[i] = sea[i]->x;
+        y[i] = sea[i]->y;
+    }
+    sprintf(path, "%s/%s", datapath(), filename);
+    CuAssertIntEquals(tc, 0, writegame(filename));
+    free_gamedata();
+
+    /* one sea region is loaded before the lighthouse, one after it */
+    CuAssertIntEquals(tc, 0, opengame(filename));
+    sea[0] = readgame_region(x[0], y[0]);
+    r = readgame_region(0, 0);
+    sea[1] = readgame_region(x[1], y[1]);
+    CuAssertPtrNotNull(tc, r);
+    CuAssertPtrNotNull(tc, r->buildings);
+    r->buildings->flags |= BLD_WORKING;
+    CuAssertTrue(tc, check_leuchtturm(sea[0], NULL));
+    CuAssertTrue(tc, check_leuchtturm(sea[1], NULL));
+    closegame();
+    CuAssertIntEquals(tc, 0, remove(path));
+    test_cleanup();
+}
+
 CuSuite *get_save_suite(void)
 {
     CuSuite *suite = CuSuiteNew();
     SUITE_ADD_TEST(suite, test_readwrite_data);
+    SUITE_ADD_TEST(suite, test_region_index);
+    SUITE_ADD_TEST(suite, test_region_index_truncated);
+    SUITE_ADD_TEST(suite, test_readgame_region);
+    SUITE_ADD_TEST(suite, test_readgame_region_links);
+    SUITE_ADD_TEST(suite, test_readgame_region_lighthouse);
     return suite;
 }
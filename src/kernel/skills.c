@@ -212,7 +212,8 @@ void sk_set(skill * sv, int level)
 
 static int rule_random_progress(void)
 {
-  return get_param_int(global.parameters, "study.random_progress", 1);
+  static rule_int rule = RULE_INT("study.random_progress", 1);
+  return rule_get_int(&rule);
 }
 
 int skill_weeks(int level)
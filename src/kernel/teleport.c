@@ -180,13 +180,9 @@ bool is_astral(const region * r)
 plane *get_astralplane(void)
 {
   static plane *astralspace;
-  static int rule_astralplane = -1;
+  static rule_int rule_astralplane = RULE_INT("modules.astralspace", 1);
   static int gamecookie = -1;
-  if (rule_astralplane < 0) {
-    rule_astralplane =
-      get_param_int(global.parameters, "modules.astralspace", 1);
-  }
-  if (!rule_astralplane) {
+  if (!rule_get_int(&rule_astralplane)) {
     return NULL;
   }
   if (gamecookie != global.cookie) {
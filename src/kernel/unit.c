@@ -173,11 +173,12 @@ static buddy *get_friends(const unit * u, int *numfriends)
     region *r = u->region;
     int number = 0;
     unit *u2;
+    static rule_int rule_alliances = RULE_INT("rules.alliances", 0);
 
     for (u2 = r->units; u2; u2 = u2->next) {
         if (u2->faction != f && u2->number > 0) {
             int allied = 0;
-            if (get_param_int(global.parameters, "rules.alliances", 0) != 0) {
+            if (rule_get_int(&rule_alliances) != 0) {
                 allied = (f->alliance && f->alliance == u2->faction->alliance);
             }
             else if (alliedunit(u, u2->faction, HELP_MONEY)
@@ -798,19 +799,13 @@ void leave_building(unit * u)
 
 bool can_leave(unit * u)
 {
-    static int gamecookie = -1;
-    static int rule_leave = -1;
+    static rule_int rule_leave = RULE_INT("rules.move.owner_leave", 0);
 
     if (!u->building) {
         return true;
     }
 
-    if (rule_leave < 0 || gamecookie != global.cookie) {
-        gamecookie = global.cookie;
-        rule_leave = get_param_int(global.parameters, "rules.move.owner_leave", 0);
-    }
-
-    if (rule_leave && u->building && u == building_owner(u->building)) {
+    if (rule_get_int(&rule_leave) && u->building && u == building_owner(u->building)) {
         return false;
     }
     return true;
@@ -1283,7 +1278,8 @@ int get_modifier(const unit * u, skill_t sk, int level, const region * r, bool n
 {
     int bskill = level;
     int skill = bskill;
-    int hunger_red_skill = -1;
+    static rule_int rule_hunger = RULE_INT("rules.hunger.reduces_skill", 2);
+    int hunger_red_skill;
 
     if (r && sk == SK_STEALTH) {
         plane *pl = rplane(r);
@@ -1300,9 +1296,7 @@ int get_modifier(const unit * u, skill_t sk, int level, const region * r, bool n
     }
     skill = skillmod(u->attribs, u, r, sk, skill, SMF_ALWAYS);
 
-    if (hunger_red_skill == -1) {
-        hunger_red_skill = get_param_int(global.parameters, "rules.hunger.reduces_skill", 2);
-    }
+    hunger_red_skill = rule_get_int(&rule_hunger);
 
     if (fval(u, UFL_HUNGER) && hunger_red_skill) {
         if (sk == SK_SAILING && skill > 2 && hunger_red_skill == 2) {
@@ -1315,20 +1309,94 @@ int get_modifier(const unit * u, skill_t sk, int level, const region * r, bool n
     return skill - bskill;
 }
 
+static int modified_skill(const unit * u, skill_t sk, int level,
+    const region * r)
+{
+    int mlevel = level + get_modifier(u, sk, level, r, false);
+
+    if (mlevel > 0) {
+        int skillcap = SkillCap(sk);
+        if (skillcap && mlevel > skillcap) {
+            return skillcap;
+        }
+        return mlevel;
+    }
+    return 0;
+}
+
+/* while reports are written, eff_skill() is asked about the same units
+ * and skills over and over. between skill_cache(true) and
+ * skill_cache(false), results go into a small direct-mapped table. an
+ * entry is only good for the same unit, skill, level, region and hunger,
+ * and as long as skill_epoch does not change. nothing may change the
+ * game while the cache is on, only configuration changes (through
+ * global.cookie) are noticed. debug builds check every hit against the
+ * uncached result.
+ */
+#define SKILLCACHE_SIZE 8191
+
+typedef struct skill_cache_entry {
+    const unit *u;
+    const region *r;
+    int sk;
+    int level;
+    int hunger;
+    unsigned int epoch;
+    int value;
+} skill_cache_entry;
+
+static skill_cache_entry *skill_cache_table;
+static unsigned int skill_epoch;
+static int skill_cookie;
+
+void skill_cache(bool enable)
+{
+    ++skill_epoch;
+    if (enable && !skill_cache_table) {
+        skill_cache_table = calloc(SKILLCACHE_SIZE, sizeof(skill_cache_entry));
+    }
+    else if (!enable) {
+        free(skill_cache_table);
+        skill_cache_table = NULL;
+    }
+}
+
+static int cached_skill(const unit * u, skill_t sk, int level,
+    const region * r)
+{
+    skill_cache_entry *e;
+    int hunger = fval(u, UFL_HUNGER) != 0;
+
+    if (skill_cookie != global.cookie) {
+        skill_cookie = global.cookie;
+        ++skill_epoch;
+    }
+    e = skill_cache_table + ((unsigned int)u->no * MAXSKILLS + sk) % SKILLCACHE_SIZE;
+    if (e->u != u || e->sk != sk || e->level != level || e->r != r
+        || e->hunger != hunger || e->epoch != skill_epoch) {
+        e->u = u;
+        e->r = r;
+        e->sk = sk;
+        e->level = level;
+        e->hunger = hunger;
+        e->epoch = skill_epoch;
+        e->value = modified_skill(u, sk, level, r);
+    }
+    else {
+        assert(e->value == modified_skill(u, sk, level, r));
+    }
+    return e->value;
+}
+
 int eff_skill(const unit * u, skill_t sk, const region * r)
 {
     if (skill_enabled(sk)) {
         int level = get_level(u, sk);
         if (level > 0) {
-            int mlevel = level + get_modifier(u, sk, level, r, false);
-
-            if (mlevel > 0) {
-                int skillcap = SkillCap(sk);
-                if (skillcap && mlevel > skillcap) {
-                    return skillcap;
-                }
-                return mlevel;
+            if (skill_cache_table) {
+                return cached_skill(u, sk, level, r);
             }
+            return modified_skill(u, sk, level, r);
         }
     }
     return 0;
@@ -168,6 +168,7 @@ extern "C" {
     const struct region *r);
   extern int eff_skill_study(const struct unit *u, skill_t sk,
     const struct region *r);
+  extern void skill_cache(bool enable);
 
   extern int get_modifier(const struct unit *u, skill_t sk, int lvl,
     const struct region *r, bool noitem);
@@ -7,6 +7,8 @@
 #include "race.h"
 #include "region.h"
 
+#include <skill.h>
+
 #include <CuTest.h>
 #include <tests.h>
 
@@ -123,6 +125,29 @@ static void test_scale_number(CuTest *tc) {
     test_cleanup();
 }
 
+static void test_skill_cache(CuTest *tc) {
+    unit *u;
+
+    test_cleanup();
+    test_create_world();
+    u = test_create_unit(test_create_faction(test_create_race("human")), findregion(0, 0));
+    set_level(u, SK_STEALTH, 4);
+    skill_cache(true);
+    CuAssertIntEquals(tc, 4, eff_skill(u, SK_STEALTH, u->region));
+    CuAssertIntEquals(tc, 4, eff_skill(u, SK_STEALTH, u->region));
+    set_level(u, SK_STEALTH, 6);
+    CuAssertIntEquals(tc, 6, eff_skill(u, SK_STEALTH, u->region));
+    fset(u, UFL_HUNGER);
+    CuAssertIntEquals(tc, 3, eff_skill(u, SK_STEALTH, u->region));
+    freset(u, UFL_HUNGER);
+    set_param(&global.parameters, "skill.maxlevel", "5");
+    CuAssertIntEquals(tc, 5, eff_skill(u, SK_STEALTH, u->region));
+    CuAssertIntEquals(tc, 0, eff_skill(u, SK_PERCEPTION, u->region));
+    skill_cache(false);
+    CuAssertIntEquals(tc, 5, eff_skill(u, SK_STEALTH, u->region));
+    test_cleanup();
+}
+
 CuSuite *get_unit_suite(void)
 {
     CuSuite *suite = CuSuiteNew();
@@ -132,5 +157,6 @@ CuSuite *get_unit_suite(void)
     SUITE_ADD_TEST(suite, test_remove_units_without_faction);
     SUITE_ADD_TEST(suite, test_remove_units_with_dead_faction);
     SUITE_ADD_TEST(suite, test_remove_empty_units_in_region);
+    SUITE_ADD_TEST(suite, test_skill_cache);
     return suite;
 }
@@ -73,8 +73,9 @@
 #define INTFLAGS_VERSION 342   /* turn 876, FFL_NPC is now bit 25, flags is an int */
 #define SAVEGAMEID_VERSION 343 /* instead of XMLNAME, save the game.id parameter from the config */
 #define BUILDNO_VERSION 344 /* storing the build number in the save */
+#define REGIONINDEX_VERSION 345 /* an index of region blocks is stored at the end of the file */
 
 #define MIN_VERSION CURSETYPE_VERSION      /* minimal datafile we support */
-#define RELEASE_VERSION BUILDNO_VERSION /* current datafile */
+#define RELEASE_VERSION REGIONINDEX_VERSION /* current datafile */
 
 #define STREAM_VERSION 2 /* internal encoding of binary files */
@@ -118,14 +118,8 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 static int RemoveNMRNewbie(void)
 {
-    static int value = -1;
-    static int gamecookie = -1;
-
-    if (value < 0 || gamecookie != global.cookie) {
-        value = get_param_int(global.parameters, "nmr.removenewbie", 0);
-        gamecookie = global.cookie;
-    }
-    return value;
+    static rule_int rule = RULE_INT("nmr.removenewbie", 0);
+    return rule_get_int(&rule);
 }
 
 static void checkorders(void)
@@ -270,11 +264,12 @@ static void peasants(region * r)
     int maxp = production(r);
     int n, satiated;
     int dead = 0;
+    static rule_int rule_growth = RULE_INT("rules.peasants.growth", 1);
 
     /* Bis zu 1000 Bauern knnen Zwillinge bekommen oder 1000 Bauern
      * wollen nicht! */
 
-    if (peasants > 0 && get_param_int(global.parameters, "rules.peasants.growth", 1)) {
+    if (peasants > 0 && rule_get_int(&rule_growth)) {
         int glueck = 0;
         double fraction = peasants * 0.0001F * PEASANTGROWTH;
         int births = (int)fraction;
@@ -698,12 +693,9 @@ void demographics(void)
             /* die Nachfrage nach Produkten steigt. */
             struct demand *dmd;
             if (r->land) {
-                static int plant_rules = -1;
+                static rule_int rule_grow = RULE_INT("rules.economy.grow", 0);
+                int plant_rules = rule_get_int(&rule_grow);
 
-                if (plant_rules < 0) {
-                    plant_rules =
-                        get_param_int(global.parameters, "rules.economy.grow", 0);
-                }
                 for (dmd = r->land->demands; dmd; dmd = dmd->next) {
                     if (dmd->value > 0 && dmd->value < MAXDEMAND) {
                         float rise = DMRISE;
@@ -908,14 +900,15 @@ int leave_cmd(unit * u, struct order *ord)
     return 0;
 }
 
+static int parse_transferquit(const char *str, int def)
+{
+    return (str != 0 && strcmp(str, "true") == 0);
+}
+
 static bool EnhancedQuit(void)
 {
-    static int value = -1;
-    if (value < 0) {
-        const char *str = get_param(global.parameters, "alliance.transferquit");
-        value = (str != 0 && strcmp(str, "true") == 0);
-    }
-    return value;
+    static rule_int rule = RULE_PARSE("alliance.transferquit", 0, parse_transferquit);
+    return rule_get_int(&rule) != 0;
 }
 
 int quit_cmd(unit * u, struct order *ord)
@@ -987,11 +980,8 @@ static int mayboard(const unit * u, ship * sh)
 
 static bool CheckOverload(void)
 {
-    static int value = -1;
-    if (value < 0) {
-        value = get_param_int(global.parameters, "rules.check_overload", 0);
-    }
-    return value;
+    static rule_int rule = RULE_INT("rules.check_overload", 0);
+    return rule_get_int(&rule) != 0;
 }
 
 int enter_ship(unit * u, struct order *ord, int id, int report)
@@ -1203,10 +1193,8 @@ int *age = NULL;
 
 static void nmr_death(faction * f)
 {
-    static int rule = -1;
-    if (rule < 0)
-        rule = get_param_int(global.parameters, "rules.nmr.destroy", 0);
-    if (rule) {
+    static rule_int rule = RULE_INT("rules.nmr.destroy", 0);
+    if (rule_get_int(&rule)) {
         unit *u;
         for (u = f->units; u; u = u->nextF) {
             if (u->building && building_owner(u->building) == u) {
@@ -1415,6 +1403,7 @@ int ally_cmd(unit * u, struct order *ord)
     }
 
     sf->status &= HelpMask();
+    allies_changed();
 
     if (sf->status == 0) {        /* Alle HELPs geloescht */
         removelist(sfp, sf);
@@ -3081,7 +3070,7 @@ int renumber_cmd(unit * u, order * ord)
     return 0;
 }
 
-static building *age_building(building * b)
+static building *age_building(building * b, int ev_timer)
 {
     const struct building_type *bt_blessed;
     const struct curse_type *ct_astralblock;
@@ -3150,7 +3139,7 @@ static building *age_building(building * b)
     }
 
     a_age(&b->attribs);
-    handle_event(b->attribs, "timer", b);
+    handle_event_id(b->attribs, ev_timer, b);
 
     if (b->type->age) {
         b->type->age(b);
@@ -3165,10 +3154,10 @@ static double rc_popularity(const struct race *rc)
     return 1.0 / (pop - MORALE_COOLDOWN); /* 10 turns average */
 }
 
-static void age_region(region * r)
+static void age_region(region * r, int ev_timer)
 {
     a_age(&r->attribs);
-    handle_event(r->attribs, "timer", r);
+    handle_event_id(r->attribs, ev_timer, r);
 
     if (!r->land)
         return;
@@ -3202,33 +3191,46 @@ static void age_region(region * r)
     }
 }
 
+/* potion effects and curses are attributes, so a unit without any
+ * attributes has nothing here that could expire, and most units have
+ * none. */
+static void age_unit_effects(unit * u, const curse_type * ct_oldrace)
+{
+    curse *c;
+    /* Goliathwasser */
+    int i = get_effect(u, oldpotiontype[P_STRONG]);
+    if (i > 0) {
+        change_effect(u, oldpotiontype[P_STRONG], -1 * _min(u->number, i));
+    }
+    /* Berserkerblut */
+    i = get_effect(u, oldpotiontype[P_BERSERK]);
+    if (i > 0) {
+        change_effect(u, oldpotiontype[P_BERSERK], -1 * _min(u->number, i));
+    }
+
+    c = get_curse(u->attribs, ct_oldrace);
+    if (curse_active(c)) {
+        if (c->duration == 1 && !(c_flags(c) & CURSE_NOAGE)) {
+            u_setrace(u, get_race(curse_geteffect_int(c)));
+            u->irace = NULL;
+        }
+    }
+}
+
 static void ageing(void)
 {
     faction *f;
     region *r;
+    const curse_type *ct_oldrace = oldcursetype(C_OLDRACE);
+    int ev_timer = event_id("timer");
 
     /* altern spezieller Attribute, die eine Sonderbehandlung brauchen?  */
     for (r = regions; r; r = r->next) {
         unit *u;
 
         for (u = r->units; u; u = u->next) {
-            /* Goliathwasser */
-            int i = get_effect(u, oldpotiontype[P_STRONG]);
-            if (i > 0) {
-                change_effect(u, oldpotiontype[P_STRONG], -1 * _min(u->number, i));
-            }
-            /* Berserkerblut */
-            i = get_effect(u, oldpotiontype[P_BERSERK]);
-            if (i > 0) {
-                change_effect(u, oldpotiontype[P_BERSERK], -1 * _min(u->number, i));
-            }
-
-            if (is_cursed(u->attribs, C_OLDRACE, 0)) {
-                curse *c = get_curse(u->attribs, ct_find("oldrace"));
-                if (c->duration == 1 && !(c_flags(c) & CURSE_NOAGE)) {
-                    u_setrace(u, get_race(curse_geteffect_int(c)));
-                    u->irace = NULL;
-                }
+            if (u->attribs) {
+                age_unit_effects(u, ct_oldrace);
             }
         }
     }
@@ -3239,7 +3241,7 @@ static void ageing(void)
     /* Factions */
     for (f = factions; f; f = f->next) {
         a_age(&f->attribs);
-        handle_event(f->attribs, "timer", f);
+        handle_event_id(f->attribs, ev_timer, f);
     }
 
     /* Regionen */
@@ -3248,14 +3250,14 @@ static void ageing(void)
         unit **up;
         ship **sp;
 
-        age_region(r);
+        age_region(r, ev_timer);
 
         /* Einheiten */
         for (up = &r->units; *up;) {
             unit *u = *up;
             a_age(&u->attribs);
             if (u == *up)
-                handle_event(u->attribs, "timer", u);
+                handle_event_id(u->attribs, ev_timer, u);
             if (u == *up)
                 up = &(*up)->next;
         }
@@ -3265,7 +3267,7 @@ static void ageing(void)
             ship *s = *sp;
             a_age(&s->attribs);
             if (s == *sp)
-                handle_event(s->attribs, "timer", s);
+                handle_event_id(s->attribs, ev_timer, s);
             if (s == *sp)
                 sp = &(*sp)->next;
         }
@@ -3273,7 +3275,7 @@ static void ageing(void)
         /* Gebude */
         for (bp = &r->buildings; *bp;) {
             building *b = *bp;
-            age_building(b);
+            age_building(b, ev_timer);
             if (b == *bp)
                 bp = &b->next;
         }
@@ -3983,9 +3985,12 @@ typedef struct processor {
         } global;
     } data;
     const char *name;
+    int calls;                  /* regions, units or orders processed */
+    clock_t cpu;                /* only measured when profiling */
 } processor;
 
 static processor *processors;
+static bool profiling;
 
 static processor *add_proc(int priority, const char *name, processor_t type)
 {
@@ -4004,7 +4009,10 @@ static processor *add_proc(int priority, const char *name, processor_t type)
     proc = (processor *)malloc(sizeof(processor));
     proc->priority = priority;
     proc->type = type;
+    proc->flags = 0;
     proc->name = name;
+    proc->calls = 0;
+    proc->cpu = 0;
     proc->next = *pproc;
     *pproc = proc;
     return proc;
@@ -4057,16 +4065,152 @@ void add_proc_unit(int priority, void(*process) (unit *), const char *name)
     }
 }
 
+static clock_t proc_start(void)
+{
+    return profiling ? clock() : 0;
+}
+
+static void proc_done(processor *proc, clock_t start)
+{
+    ++proc->calls;
+    if (profiling) {
+        proc->cpu += clock() - start;
+    }
+}
+
+/* does the unit have any order with one of the keywords of this step? */
+static bool has_step_orders(const unit *u, const bool *kwds)
+{
+    const order *ord;
+    keyword_t kwd = getkeyword(u->thisorder);
+    if (kwd != NOKEYWORD && kwds[kwd]) {
+        return true;
+    }
+    for (ord = u->orders; ord; ord = ord->next) {
+        kwd = getkeyword(ord);
+        if (kwd != NOKEYWORD && kwds[kwd]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* run the region, unit and order processors of one step for region r.
+ * kwds flags the keywords that the step has order processors for.
+ */
+static void process_region(processor *pglobal, int prio, region *r,
+    const bool *kwds)
+{
+    unit *u;
+    processor *pregion = pglobal;
+
+    while (pregion && pregion->priority == prio
+        && pregion->type == PR_REGION_PRE) {
+        clock_t start = proc_start();
+        pregion->data.per_region.process(r);
+        proc_done(pregion, start);
+        pregion = pregion->next;
+    }
+    if (pregion == NULL || pregion->priority != prio)
+        return;
+
+    if (r->units) {
+        for (u = r->units; u; u = u->next) {
+            processor *porder, *punit = pregion;
+
+            while (punit && punit->priority == prio && punit->type == PR_UNIT) {
+                clock_t start = proc_start();
+                punit->data.per_unit.process(u);
+                proc_done(punit, start);
+                punit = punit->next;
+            }
+            if (punit == NULL || punit->priority != prio)
+                continue;
+
+            /* most units have none of the orders this step is looking for */
+            if (!has_step_orders(u, kwds))
+                continue;
+
+            porder = punit;
+            while (porder && porder->priority == prio && porder->type == PR_ORDER) {
+                order **ordp = &u->orders;
+                if (porder->flags & PROC_THISORDER)
+                    ordp = &u->thisorder;
+                while (*ordp) {
+                    order *ord = *ordp;
+                    if (getkeyword(ord) == porder->data.per_order.kword) {
+                        if (porder->flags & PROC_LONGORDER) {
+                            if (u->number == 0) {
+                                ord = NULL;
+                            }
+                            else if (u_race(u) == get_race(RC_INSECT)
+                                && r_insectstalled(r)
+                                && !is_cursed(u->attribs, C_KAELTESCHUTZ, 0)) {
+                                ord = NULL;
+                            }
+                            else if (LongHunger(u)) {
+                                cmistake(u, ord, 224, MSG_MAGIC);
+                                ord = NULL;
+                            }
+                            else if (fval(u, UFL_LONGACTION)) {
+                                /* this message was already given in laws.update_long_order
+                                   cmistake(u, ord, 52, MSG_PRODUCE);
+                                   */
+                                ord = NULL;
+                            }
+                            else if (fval(r->terrain, SEA_REGION)
+                                && u_race(u) != get_race(RC_AQUARIAN)
+                                && !(u_race(u)->flags & RCF_SWIM)) {
+                                /* error message disabled by popular demand */
+                                ord = NULL;
+                            }
+                        }
+                        if (ord) {
+                            clock_t start = proc_start();
+                            porder->data.per_order.process(u, ord);
+                            proc_done(porder, start);
+                        }
+                    }
+                    if (!ord || *ordp == ord)
+                        ordp = &(*ordp)->next;
+                }
+                porder = porder->next;
+            }
+        }
+    }
+
+    while (pregion && pregion->priority == prio
+        && pregion->type != PR_REGION_POST) {
+        pregion = pregion->next;
+    }
+
+    while (pregion && pregion->priority == prio
+        && pregion->type == PR_REGION_POST) {
+        clock_t start = proc_start();
+        pregion->data.per_region.process(r);
+        proc_done(pregion, start);
+        pregion = pregion->next;
+    }
+}
+
 /* per priority, execute processors in order from PR_GLOBAL down to PR_ORDER */
 void process(void)
 {
     processor *proc = processors;
     faction *f;
+    bool kwds[MAXKEYWORDS];
+
+    profiling = get_param_int(global.parameters, "debug.profile", 0) != 0;
+    for (proc = processors; proc; proc = proc->next) {
+        proc->calls = 0;
+        proc->cpu = 0;
+    }
+    proc = processors;
 
     while (proc) {
         int prio = proc->priority;
         region *r;
-        processor *pglobal = proc;
+        processor *porder, *pglobal = proc;
 
         if (verbosity >= 3)
             printf("- Step %u\n", prio);
@@ -4077,94 +4221,22 @@ void process(void)
         }
 
         while (pglobal && pglobal->priority == prio && pglobal->type == PR_GLOBAL) {
+            clock_t start = proc_start();
             pglobal->data.global.process();
+            proc_done(pglobal, start);
             pglobal = pglobal->next;
         }
         if (pglobal == NULL || pglobal->priority != prio)
             continue;
 
-        for (r = regions; r; r = r->next) {
-            unit *u;
-            processor *pregion = pglobal;
-
-            while (pregion && pregion->priority == prio
-                && pregion->type == PR_REGION_PRE) {
-                pregion->data.per_region.process(r);
-                pregion = pregion->next;
-            }
-            if (pregion == NULL || pregion->priority != prio)
-                continue;
-
-            if (r->units) {
-                for (u = r->units; u; u = u->next) {
-                    processor *porder, *punit = pregion;
-
-                    while (punit && punit->priority == prio && punit->type == PR_UNIT) {
-                        punit->data.per_unit.process(u);
-                        punit = punit->next;
-                    }
-                    if (punit == NULL || punit->priority != prio)
-                        continue;
-
-                    porder = punit;
-                    while (porder && porder->priority == prio && porder->type == PR_ORDER) {
-                        order **ordp = &u->orders;
-                        if (porder->flags & PROC_THISORDER)
-                            ordp = &u->thisorder;
-                        while (*ordp) {
-                            order *ord = *ordp;
-                            if (getkeyword(ord) == porder->data.per_order.kword) {
-                                if (porder->flags & PROC_LONGORDER) {
-                                    if (u->number == 0) {
-                                        ord = NULL;
-                                    }
-                                    else if (u_race(u) == get_race(RC_INSECT)
-                                        && r_insectstalled(r)
-                                        && !is_cursed(u->attribs, C_KAELTESCHUTZ, 0)) {
-                                        ord = NULL;
-                                    }
-                                    else if (LongHunger(u)) {
-                                        cmistake(u, ord, 224, MSG_MAGIC);
-                                        ord = NULL;
-                                    }
-                                    else if (fval(u, UFL_LONGACTION)) {
-                                        /* this message was already given in laws.update_long_order
-                                           cmistake(u, ord, 52, MSG_PRODUCE);
-                                           */
-                                        ord = NULL;
-                                    }
-                                    else if (fval(r->terrain, SEA_REGION)
-                                        && u_race(u) != get_race(RC_AQUARIAN)
-                                        && !(u_race(u)->flags & RCF_SWIM)) {
-                                        /* error message disabled by popular demand */
-                                        ord = NULL;
-                                    }
-                                }
-                                if (ord) {
-                                    porder->data.per_order.process(u, ord);
-                                }
-                            }
-                            if (!ord || *ordp == ord)
-                                ordp = &(*ordp)->next;
-                        }
-                        porder = porder->next;
-                    }
-                }
+        memset(kwds, 0, sizeof(kwds));
+        for (porder = pglobal; porder && porder->priority == prio; porder = porder->next) {
+            if (porder->type == PR_ORDER) {
+                kwds[porder->data.per_order.kword] = true;
             }
-
-            while (pregion && pregion->priority == prio
-                && pregion->type != PR_REGION_POST) {
-                pregion = pregion->next;
-            }
-
-            while (pregion && pregion->priority == prio
-                && pregion->type == PR_REGION_POST) {
-                pregion->data.per_region.process(r);
-                pregion = pregion->next;
-            }
-            if (pregion == NULL || pregion->priority != prio)
-                continue;
-
+        }
+        for (r = regions; r; r = r->next) {
+            process_region(pglobal, prio, r, kwds);
         }
     }
 
@@ -4185,6 +4257,46 @@ void process(void)
 
 }
 
+static const char *proc_name(const processor *proc)
+{
+    if (proc->name) {
+        return proc->name;
+    }
+    if (proc->type == PR_ORDER) {
+        return keywords[proc->data.per_order.kword];
+    }
+    return "";
+}
+
+/** write the statistics of the last process() run as CSV.
+ * one line per processor, calls counts the regions, units or orders
+ * it was called for, cpu is the processor time from clock() in
+ * milliseconds. time spent waiting for I/O is not included. the last lines count
+ * queries of the help matrix and how often it had to be rebuilt.
+ */
+int write_profile(const char *filename)
+{
+    static const char *types[] = { "global", "region", "unit", "order", "postregion" };
+    processor *proc;
+    int queries, rebuilds;
+    FILE *F = fopen(filename, "w");
+
+    if (!F) {
+        perror(filename);
+        return -1;
+    }
+    fputs("priority;type;name;calls;cpu\n", F);
+    for (proc = processors; proc; proc = proc->next) {
+        fprintf(F, "%d;%s;\"%s\";%d;%.0f\n", proc->priority, types[proc->type],
+            proc_name(proc), proc->calls, proc->cpu * 1000.0 / CLOCKS_PER_SEC);
+    }
+    ally_stats(&queries, &rebuilds);
+    fprintf(F, "0;counter;\"ally queries\";%d;0\n", queries);
+    fprintf(F, "0;counter;\"ally rebuilds\";%d;0\n", rebuilds);
+    fclose(F);
+    return 0;
+}
+
 int siege_cmd(unit * u, order * ord)
 {
     region *r = u->region;
@@ -4325,6 +4437,9 @@ void init_processor(void)
 {
     int p;
 
+    if (processors) {
+        return;
+    }
     p = 10;
     add_proc_global(p, &new_units, "Neue Einheiten erschaffen");
 
@@ -4472,14 +4587,15 @@ void init_processor(void)
 
 void processorders(void)
 {
-    static int init = 0;
-
-    if (!init) {
-        init_processor();
-        init = 1;
-    }
+    init_processor();
     update_spells();
+    ally_stats(NULL, NULL);
     process();
+    if (profiling) {
+        char zText[MAX_PATH];
+        sprintf(zText, "%s/profile-%d.csv", basepath(), turn);
+        write_profile(zText);
+    }
     /*************************************************/
 
     if (get_param_int(global.parameters, "modules.markets", 0)) {
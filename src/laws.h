@@ -39,6 +39,9 @@ extern "C" {
 
 /* eressea-specific. put somewhere else, please. */
   void processorders(void);
+  void init_processor(void);
+  void process(void);
+  int write_profile(const char *filename);
   extern struct attrib_type at_germs;
 
   extern int dropouts[2];
@@ -19,6 +19,9 @@
 #include <tests.h>
 
 #include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 static void test_new_building_can_be_renamed(CuTest * tc)
 {
@@ -392,6 +395,56 @@ static void test_reserve_self(CuTest *tc) {
     test_cleanup();
 }
 
+static int profile_calls(const char *filename, const char *name)
+{
+    char line[256], key[64];
+    int calls = -1;
+    FILE *F = fopen(filename, "r");
+
+    sprintf(key, ";\"%s\";", name);
+    while (F && fgets(line, sizeof(line), F)) {
+        const char *pos = strstr(line, key);
+        if (pos) {
+            calls = atoi(pos + strlen(key));
+            break;
+        }
+    }
+    if (F) fclose(F);
+    return calls;
+}
+
+static void test_process_profile(CuTest *tc) {
+    const char *filename = "profile-test.csv";
+    const struct locale *loc;
+    faction *f;
+    region *r;
+    unit *u;
+    int nregions = 0;
+
+    test_cleanup();
+    test_create_world();
+    loc = get_locale("de");
+    f = test_create_faction(NULL);
+    u = test_create_unit(f, findregion(0, 0));
+    u->orders = create_order(K_BANNER, loc, "hurr");
+    test_create_unit(f, findregion(1, 0));
+    test_create_unit(f, findregion(1, 0));
+    for (r = regions; r; r = r->next) {
+        ++nregions;
+    }
+    set_param(&global.parameters, "debug.profile", "1");
+    init_processor();
+    process();
+    CuAssertIntEquals(tc, 0, write_profile(filename));
+    CuAssertIntEquals(tc, 1, profile_calls(filename, "Neue Einheiten erschaffen"));
+    CuAssertIntEquals(tc, nregions, profile_calls(filename, "Kontaktieren"));
+    CuAssertIntEquals(tc, 3, profile_calls(filename, "Langen Befehl aktualisieren"));
+    CuAssertIntEquals(tc, 1, profile_calls(filename, "banner"));
+    CuAssertIntEquals(tc, 0, profile_calls(filename, "email"));
+    remove(filename);
+    test_cleanup();
+}
+
 CuSuite *get_laws_suite(void)
 {
     CuSuite *suite = CuSuiteNew();
@@ -411,6 +464,7 @@ CuSuite *get_laws_suite(void)
     SUITE_ADD_TEST(suite, test_reserve_self);
     SUITE_ADD_TEST(suite, test_reserve_cmd);
     SUITE_ADD_TEST(suite, test_new_units);
+    SUITE_ADD_TEST(suite, test_process_profile);
     SUITE_ADD_TEST(suite, test_cannot_create_unit_above_limit);
     return suite;
 }
@@ -434,11 +434,10 @@ static attrib *set_new_dragon_target(unit * u, region * r, int range)
   return NULL;
 }
 
-static order *make_movement_order(unit * u, const region * target, int moves,
-  bool(*allowed) (const region *, const region *))
+/* MOVE order for the first steps of a path from path_find(). only the
+ * directions are formatted, the keyword does not go through the parser. */
+static order *make_path_order(const unit * u, region ** plan, int moves)
 {
-  region *r = u->region;
-  region **plan;
   int bytes, position = 0;
   char zOrder[128], *bufp = zOrder;
   size_t size = sizeof(zOrder) - 1;
@@ -446,22 +445,12 @@ static order *make_movement_order(unit * u, const region * target, int moves,
   if (monster_is_waiting(u))
     return NULL;
 
-  plan = path_find(r, target, DRAGON_RANGE * 5, allowed);
-  if (plan == NULL)
-    return NULL;
-
-  bytes =
-    (int)strlcpy(bufp,
-    (const char *)LOC(u->faction->locale, keyword(K_MOVE)), size);
-  if (wrptr(&bufp, &size, bytes) != 0)
-    WARN_STATIC_BUFFER();
-
   while (position != moves && plan[position + 1]) {
     region *prev = plan[position];
     region *next = plan[++position];
     direction_t dir = reldirection(prev, next);
     assert(dir != NODIRECTION && dir != D_SPECIAL);
-    if (size > 1) {
+    if (position > 1 && size > 1) {
       *bufp++ = ' ';
       --size;
     }
@@ -473,7 +462,21 @@ static order *make_movement_order(unit * u, const region * target, int moves,
   }
 
   *bufp = 0;
-  return parse_order(zOrder, u->faction->locale);
+  return create_order(K_MOVE, u->faction->locale, "%s", zOrder);
+}
+
+static order *make_movement_order(unit * u, const region * target, int moves,
+  bool(*allowed) (const region *, const region *))
+{
+  region *plan[DRAGON_RANGE * 5 + 2];
+
+  if (monster_is_waiting(u))
+    return NULL;
+
+  if (!path_find(u->region, target, DRAGON_RANGE * 5, allowed, plan))
+    return NULL;
+
+  return make_path_order(u, plan, moves);
 }
 
 #ifdef TODO_ALP
@@ -650,7 +653,8 @@ static order *plan_dragon(unit * u)
   attrib *ta = a_find(u->attribs, &at_targetregion);
   region *r = u->region;
   region *tr = NULL;
-  bool move = false;
+  region *plan[DRAGON_RANGE + 2];
+  bool move = false, planned = false;
   order *long_order = NULL;
 
   reduce_weight(u);
@@ -683,27 +687,35 @@ static order *plan_dragon(unit * u)
     ta = a_find(u->attribs, &at_targetregion);
   if (ta != NULL) {
     tr = (region *) ta->data.v;
-    if (tr == NULL || !path_exists(u->region, tr, DRAGON_RANGE, allowed_dragon)) {
+    /* the path that proves the target is reachable is also the one we
+     * take, so it is only searched for once */
+    planned = tr && path_find(u->region, tr, DRAGON_RANGE, allowed_dragon, plan);
+    if (!planned) {
       ta = set_new_dragon_target(u, u->region, DRAGON_RANGE);
       if (ta)
         tr = findregion(ta->data.sa[0], ta->data.sa[1]);
     }
   }
   if (tr != NULL) {
+    int moves = 0;
     assert(long_order == NULL);
     switch (old_race(u_race(u))) {
     case RC_FIREDRAGON:
-      long_order = make_movement_order(u, tr, 4, allowed_dragon);
+      moves = 4;
       break;
     case RC_DRAGON:
-      long_order = make_movement_order(u, tr, 3, allowed_dragon);
+      moves = 3;
       break;
     case RC_WYRM:
-      long_order = make_movement_order(u, tr, 1, allowed_dragon);
+      moves = 1;
       break;
     default:
       break;
     }
+    if (moves > 0) {
+      long_order = planned ? make_path_order(u, plan, moves)
+        : make_movement_order(u, tr, moves, allowed_dragon);
+    }
     if (rng_int() % 100 < 15) {
       const struct locale *lang = u->faction->locale;
       /* do a growl */
@@ -746,128 +758,141 @@ static order *plan_dragon(unit * u)
   return long_order;
 }
 
-void plan_monsters(faction * f)
+static void plan_monster(faction * f, unit * u, bool attacking)
 {
-  region *r;
-
-  assert(f);
-  f->lastorders = turn;
-
-  for (r = regions; r; r = r->next) {
-    unit *u;
-    double attack_chance = monster_attack_chance();
-    bool attacking = false;
-
-    for (u = r->units; u; u = u->next) {
-      attrib *ta;
-      order *long_order = NULL;
+  attrib *ta;
+  order *long_order = NULL;
 
-      /* Ab hier nur noch Befehle fr NPC-Einheiten. */
-      if (!is_monsters(u->faction))
-        continue;
+  if (u->status > ST_BEHIND) {
+    setstatus(u, ST_FIGHT);
+    /* all monsters fight */
+  }
+  if (skill_enabled(SK_PERCEPTION)) {
+    /* Monster bekommen jede Runde ein paar Tage Wahrnehmung dazu */
+    /* TODO: this only works for playerrace */
+    produceexp(u, SK_PERCEPTION, u->number);
+  }
 
-      if (attack_chance > 0.0) {
-        if (chance(attack_chance))
-          attacking = true;
-        attack_chance = 0.0;
-      }
+  /* Befehle mssen jede Runde neu gegeben werden: */
+  free_orders(&u->orders);
 
-      if (u->status > ST_BEHIND) {
-        setstatus(u, ST_FIGHT);
-        /* all monsters fight */
-      }
-      if (skill_enabled(SK_PERCEPTION)) {
-        /* Monster bekommen jede Runde ein paar Tage Wahrnehmung dazu */
-        /* TODO: this only works for playerrace */
-        produceexp(u, SK_PERCEPTION, u->number);
+  if (attacking && is_guard(u, GUARD_TAX)) {
+    monster_attacks(u);
+  }
+  /* units with a plan to kill get ATTACK orders: */
+  ta = a_find(u->attribs, &at_hate);
+  if (ta && !monster_is_waiting(u)) {
+    unit *tu = (unit *) ta->data.v;
+    if (tu && tu->region == u->region) {
+      addlist(&u->orders,
+        create_order(K_ATTACK, u->faction->locale, "%i", tu->no));
+    } else if (tu) {
+      tu = findunitg(ta->data.i, NULL);
+      if (tu != NULL) {
+        long_order = make_movement_order(u, tu->region, 2, allowed_walk);
       }
+    } else
+      a_remove(&u->attribs, ta);
+  }
 
-      /* Befehle mssen jede Runde neu gegeben werden: */
-      free_orders(&u->orders);
+  /* All monsters guard the region: */
+  if (!monster_is_waiting(u) && u->region->land) {
+    addlist(&u->orders, create_order(K_GUARD, u->faction->locale, NULL));
+  }
 
-      if (attacking && is_guard(u, GUARD_TAX)) {
-        monster_attacks(u);
+  /* Einheiten mit Bewegungsplan kriegen ein NACH: */
+  if (long_order == NULL) {
+    attrib *ta = a_find(u->attribs, &at_targetregion);
+    if (ta) {
+      if (u->region == (region *) ta->data.v) {
+        a_remove(&u->attribs, ta);
       }
-      /* units with a plan to kill get ATTACK orders: */
-      ta = a_find(u->attribs, &at_hate);
-      if (ta && !monster_is_waiting(u)) {
-        unit *tu = (unit *) ta->data.v;
-        if (tu && tu->region == r) {
-          addlist(&u->orders,
-            create_order(K_ATTACK, u->faction->locale, "%i", tu->no));
-        } else if (tu) {
-          tu = findunitg(ta->data.i, NULL);
-          if (tu != NULL) {
-            long_order = make_movement_order(u, tu->region, 2, allowed_walk);
-          }
-        } else
-          a_remove(&u->attribs, ta);
+    } else if (u_race(u)->flags & RCF_MOVERANDOM) {
+      if (rng_int() % 100 < MOVECHANCE || check_overpopulated(u)) {
+        long_order = monster_move(u->region, u);
       }
+    }
+  }
 
-      /* All monsters guard the region: */
-      if (!monster_is_waiting(u) && r->land) {
-        addlist(&u->orders, create_order(K_GUARD, u->faction->locale, NULL));
+  if (long_order == NULL) {
+    /* Einheiten, die Waffenlosen Kampf lernen knnten, lernen es um 
+     * zu bewachen: */
+    if (u_race(u)->bonus[SK_WEAPONLESS] != -99) {
+      if (eff_skill(u, SK_WEAPONLESS, u->region) < 1) {
+        long_order =
+          create_order(K_STUDY, f->locale, "'%s'",
+          skillname(SK_WEAPONLESS, f->locale));
       }
+    }
+  }
 
-      /* Einheiten mit Bewegungsplan kriegen ein NACH: */
-      if (long_order == NULL) {
-        attrib *ta = a_find(u->attribs, &at_targetregion);
-        if (ta) {
-          if (u->region == (region *) ta->data.v) {
-            a_remove(&u->attribs, ta);
-          }
-        } else if (u_race(u)->flags & RCF_MOVERANDOM) {
-          if (rng_int() % 100 < MOVECHANCE || check_overpopulated(u)) {
-            long_order = monster_move(r, u);
-          }
-        }
-      }
+  if (long_order == NULL) {
+    /* Ab hier noch nicht generalisierte Spezialbehandlungen. */
 
-      if (long_order == NULL) {
-        /* Einheiten, die Waffenlosen Kampf lernen knnten, lernen es um 
-         * zu bewachen: */
-        if (u_race(u)->bonus[SK_WEAPONLESS] != -99) {
-          if (eff_skill(u, SK_WEAPONLESS, u->region) < 1) {
-            long_order =
-              create_order(K_STUDY, f->locale, "'%s'",
-              skillname(SK_WEAPONLESS, f->locale));
-          }
-        }
+    if (!u->orders) {
+      handle_event(u->attribs, "ai_move", u);
+    }
+
+    switch (old_race(u_race(u))) {
+    case RC_SEASERPENT:
+      long_order = create_order(K_PIRACY, f->locale, NULL);
+      break;
+#ifdef TODO_ALP
+    case RC_ALP:
+      long_order = monster_seeks_target(u->region, u);
+      break;
+#endif
+    case RC_FIREDRAGON:
+    case RC_DRAGON:
+    case RC_WYRM:
+      long_order = plan_dragon(u);
+      break;
+    default:
+      if (u_race(u)->flags & RCF_LEARN) {
+        long_order = monster_learn(u);
       }
+      break;
+    }
+  }
+  if (long_order) {
+    addlist(&u->orders, long_order);
+  }
+}
 
-      if (long_order == NULL) {
-        /* Ab hier noch nicht generalisierte Spezialbehandlungen. */
+void plan_monsters(faction * f)
+{
+  faction *fm;
+  double attack_chance = monster_attack_chance();
+  quicklist *rolled = 0, *attacks = 0;
 
-        if (!u->orders) {
-          handle_event(u->attribs, "ai_move", u);
-        }
+  assert(f);
+  f->lastorders = turn;
 
-        switch (old_race(u_race(u))) {
-        case RC_SEASERPENT:
-          long_order = create_order(K_PIRACY, f->locale, NULL);
-          break;
-#ifdef TODO_ALP
-        case RC_ALP:
-          long_order = monster_seeks_target(r, u);
-          break;
-#endif
-        case RC_FIREDRAGON:
-        case RC_DRAGON:
-        case RC_WYRM:
-          long_order = plan_dragon(u);
-          break;
-        default:
-          if (u_race(u)->flags & RCF_LEARN) {
-            long_order = monster_learn(u);
-          }
-          break;
+  /* walk the units of the monster factions instead of the whole world.
+   * whether monsters attack is decided once per region. */
+  for (fm = factions; fm; fm = fm->next) {
+    unit *u;
+    if (!is_monsters(fm))
+      continue;
+    for (u = fm->units; u; u = u->nextF) {
+      int qi;
+      quicklist *ql = rolled;
+      region *r = u->region;
+      bool attacking;
+
+      if (!ql_set_find(&ql, &qi, r)) {
+        ql_set_insert(&rolled, r);
+        if (attack_chance > 0.0 && chance(attack_chance)) {
+          ql_set_insert(&attacks, r);
         }
       }
-      if (long_order) {
-        addlist(&u->orders, long_order);
-      }
+      ql = attacks;
+      attacking = ql_set_find(&ql, &qi, r);
+      plan_monster(f, u, attacking);
     }
   }
+  ql_free(rolled);
+  ql_free(attacks);
   pathfinder_cleanup();
 }
 
@@ -187,7 +187,7 @@ attrib_type at_speedup = {
 
 /* ------------------------------------------------------------- */
 
-static attrib_type at_driveweight = {
+attrib_type at_driveweight = {
     "driveweight", NULL, NULL, NULL, NULL, NULL
 };
 
@@ -743,17 +743,15 @@ static void set_coast(ship * sh, region * r, region * rnext)
 
 static float damage_drift(void)
 {
-    static float value = -1.0F;
-    if (value < 0) {
-        value = get_param_flt(global.parameters, "rules.ship.damage_drift", 0.02F);
-    }
-    return value;
+    static rule_flt rule = RULE_FLT("rules.ship.damage_drift", 0.02F);
+    return rule_get_flt(&rule);
 }
 
 static void drifting_ships(region * r)
 {
     direction_t d;
-    bool drift = get_param_int(global.parameters, "rules.ship.drifting", 1) != 0;
+    static rule_int rule_drifting = RULE_INT("rules.ship.drifting", 1);
+    bool drift = rule_get_int(&rule_drifting) != 0;
 
     if (fval(r->terrain, SEA_REGION)) {
         ship **shp = &r->ships;
@@ -888,25 +886,20 @@ static unit *bewegung_blockiert_von(unit * reisender, region * r)
     unit *guard = NULL;
     int guard_count = 0;
     int stealth = eff_stealth(reisender, r);
-    static int gamecookie = -1;
-    static double base_prob = -999;
-    static double skill_prob = -999;
-    static double amulet_prob = -999;
-    static double guard_number_prob = -999;
-    static double castle_prob = -999;
-    static double region_type_prob = -999;
+    static rule_flt rule_base = RULE_FLT("rules.guard.base_stop_prob", .3f);
+    static rule_flt rule_skill = RULE_FLT("rules.guard.skill_stop_prob", .1f);
+    static rule_flt rule_amulet = RULE_FLT("rules.guard.amulet_stop_prob", .1f);
+    static rule_flt rule_guard_number = RULE_FLT("rules.guard.guard_number_stop_prob", .001f);
+    static rule_flt rule_castle = RULE_FLT("rules.guard.castle_stop_prob", .1f);
+    static rule_flt rule_region_type = RULE_FLT("rules.guard.region_type_stop_prob", .1f);
+    double base_prob = rule_get_flt(&rule_base);
+    double skill_prob = rule_get_flt(&rule_skill);
+    double amulet_prob = rule_get_flt(&rule_amulet);
+    double guard_number_prob = rule_get_flt(&rule_guard_number);
+    double castle_prob = rule_get_flt(&rule_castle);
+    double region_type_prob = rule_get_flt(&rule_region_type);
     const struct resource_type *ramulet = get_resourcetype(R_AMULET_OF_TRUE_SEEING);
 
-    if (gamecookie < 0 || gamecookie != global.cookie) {
-        base_prob = get_param_flt(global.parameters, "rules.guard.base_stop_prob", .3f);
-        skill_prob = get_param_flt(global.parameters, "rules.guard.skill_stop_prob", .1f);
-        amulet_prob = get_param_flt(global.parameters, "rules.guard.amulet_stop_prob", .1f);
-        guard_number_prob = get_param_flt(global.parameters, "rules.guard.guard_number_stop_prob", .001f);
-        castle_prob = get_param_flt(global.parameters, "rules.guard.castle_stop_prob", .1f);
-        region_type_prob = get_param_flt(global.parameters, "rules.guard.region_type_stop_prob", .1f);
-        gamecookie = global.cookie;
-    }
-
     if (fval(u_race(reisender), RCF_ILLUSIONARY))
         return NULL;
     for (u = r->units; u; u = u->next) {
@@ -1233,47 +1226,118 @@ static void cycle_route(order * ord, unit * u, int gereist)
     free_order(norder);
 }
 
-static bool transport(unit * ut, unit * u)
+static bool can_move(const unit * u)
 {
-    order *ord;
-
-    if (LongHunger(u) || fval(ut->region->terrain, SEA_REGION)) {
+    if (u_race(u)->flags & RCF_CANNOTMOVE)
         return false;
+    if (get_movement(&u->attribs, MV_CANNOTMOVE))
+        return false;
+    return true;
+}
+
+/* the units named in one region's TRANSPORT orders, and the units that
+ * the drivers in it are trying to ride with. each order is parsed only
+ * once per turn, the pairs are sorted by unit number and then matched up
+ * by binary search.
+ */
+typedef struct transport_pair {
+    unit *u;                    /* the carrier, or the driver */
+    unit *target;
+    bool first;                 /* first unit in its TRANSPORT order */
+} transport_pair;
+
+static transport_pair *carried, *driving;
+static int max_carried, max_driving;
+
+static int cmp_pair(const void *a, const void *b)
+{
+    const transport_pair *pa = (const transport_pair *)a;
+    const transport_pair *pb = (const transport_pair *)b;
+    if (pa->u != pb->u) {
+        return (pa->u->no < pb->u->no) ? -1 : 1;
+    }
+    if (pa->target != pb->target) {
+        return (pa->target->no < pb->target->no) ? -1 : 1;
     }
+    return (int)pb->first - (int)pa->first;
+}
 
-    for (ord = ut->orders; ord; ord = ord->next) {
-        if (getkeyword(ord) == K_TRANSPORT) {
-            init_order(ord);
-            if (getunit(ut->region, ut->faction) == u) {
-                return true;
-            }
+static transport_pair *add_pair(transport_pair ** pairs, int *size, int n)
+{
+    if (n == *size) {
+        *size = *size ? *size * 2 : 64;
+        *pairs = (transport_pair *)realloc(*pairs, *size * sizeof(transport_pair));
+    }
+    return *pairs + n;
+}
+
+static unit *driver_target(int ndriving, const unit * u)
+{
+    int lo = 0, hi = ndriving;
+
+    /* driving is sorted by driver, every driver is in it only once */
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (driving[mid].u->no < u->no) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
         }
     }
-    return false;
+    return (lo < ndriving && driving[lo].u == u) ? driving[lo].target : NULL;
 }
 
-static bool can_move(const unit * u)
+static bool is_driver(const unit * u)
 {
-    if (u_race(u)->flags & RCF_CANNOTMOVE)
-        return false;
-    if (get_movement(&u->attribs, MV_CANNOTMOVE))
-        return false;
-    return true;
+    return getkeyword(u->thisorder) == K_DRIVE && can_move(u)
+        && !fval(u, UFL_NOTMOVING) && !LongHunger(u);
 }
 
-static void init_transportation(void)
+void init_transportation(void)
 {
     region *r;
 
     for (r = regions; r; r = r->next) {
         unit *u;
+        int i, ncarried = 0, ndriving = 0;
+        bool land = !fval(r->terrain, SEA_REGION);
+
+        /* everyone that is named in a TRANSPORT order. nobody can be
+         * carried at sea, so there is no need to look there. */
+        if (land) {
+            for (u = r->units; u; u = u->next) {
+                order *ord;
+                for (ord = u->orders; ord; ord = ord->next) {
+                    if (getkeyword(ord) == K_TRANSPORT) {
+                        bool first = true;
+                        init_order(ord);
+                        for (;;) {
+                            transport_pair *tp;
+                            unit *ut = getunit(r, u->faction);
+
+                            if (ut == NULL)
+                                break;
+                            tp = add_pair(&carried, &max_carried, ncarried++);
+                            tp->u = u;
+                            tp->target = ut;
+                            tp->first = first;
+                            first = false;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (ncarried > 1) {
+            qsort(carried, ncarried, sizeof(transport_pair), cmp_pair);
+        }
 
-        /* This is just a simple check for non-corresponding K_TRANSPORT/
-         * K_DRIVE. This is time consuming for an error check, but there
-         * doesn't seem to be an easy way to speed this up. */
+        /* the drivers, and whom they want to travel with. only the first
+         * unit of a TRANSPORT order answers a DRIVE. */
         for (u = r->units; u; u = u->next) {
-            if (getkeyword(u->thisorder) == K_DRIVE && can_move(u)
-                && !fval(u, UFL_NOTMOVING) && !LongHunger(u)) {
+            if (is_driver(u)) {
+                transport_pair *tp, key;
                 unit *ut;
 
                 init_order(u->thisorder);
@@ -1283,7 +1347,15 @@ static void init_transportation(void)
                         "feedback_unit_not_found", ""));
                     continue;
                 }
-                if (!transport(ut, u)) {
+                tp = add_pair(&driving, &max_driving, ndriving++);
+                tp->u = u;
+                tp->target = ut;
+                tp->first = false;
+
+                key.u = ut;
+                key.target = u;
+                key.first = true;
+                if (ncarried == 0 || !bsearch(&key, carried, ncarried, sizeof(transport_pair), cmp_pair)) {
                     if (cansee(u->faction, r, ut, 0)) {
                         cmistake(u, u->thisorder, 286, MSG_MOVE);
                     }
@@ -1294,37 +1366,25 @@ static void init_transportation(void)
                 }
             }
         }
+        if (ndriving == 0) {
+            continue;
+        }
 
         /* This calculates the weights of all transported units and
          * adds them to an internal counter which is used by travel () to
          * calculate effective weight and movement. */
-
-        if (!fval(r->terrain, SEA_REGION)) {
-            for (u = r->units; u; u = u->next) {
-                order *ord;
-                int w = 0;
-
-                for (ord = u->orders; ord; ord = ord->next) {
-                    if (getkeyword(ord) == K_TRANSPORT) {
-                        init_order(ord);
-                        for (;;) {
-                            unit *ut = getunit(r, u->faction);
-
-                            if (ut == NULL)
-                                break;
-                            if (getkeyword(ut->thisorder) == K_DRIVE && can_move(ut)
-                                && !fval(ut, UFL_NOTMOVING) && !LongHunger(ut)) {
-                                init_order(ut->thisorder);
-                                if (getunit(r, ut->faction) == u) {
-                                    w += weight(ut);
-                                }
-                            }
-                        }
-                    }
+        qsort(driving, ndriving, sizeof(transport_pair), cmp_pair);
+        for (i = 0; i != ncarried;) {
+            int w = 0;
+            u = carried[i].u;
+            for (; i != ncarried && carried[i].u == u; ++i) {
+                unit *ut = carried[i].target;
+                if (driver_target(ndriving, ut) == u) {
+                    w += weight(ut);
                 }
-                if (w > 0)
-                    a_add(&u->attribs, a_new(&at_driveweight))->data.i = w;
             }
+            if (w > 0)
+                a_add(&u->attribs, a_new(&at_driveweight))->data.i = w;
         }
     }
 }
@@ -1906,7 +1966,8 @@ sail(unit * u, order * ord, bool move_on_land, region_list ** routep)
             /* storms should be the first thing we do. */
             stormchance = stormyness / shipspeed(sh, u);
             if (check_leuchtturm(next_point, NULL)) {
-                int param = get_param_int(global.parameters, "rules.lighthous.stormchancedevisor", 0);
+                static rule_int rule_devisor = RULE_INT("rules.lighthous.stormchancedevisor", 0);
+                int param = rule_get_int(&rule_devisor);
                 if (param > 0) {
                     stormchance /= param;
                 }
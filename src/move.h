@@ -30,6 +30,7 @@ extern "C" {
     struct building_type;
 
     extern struct attrib_type at_speedup;
+    extern struct attrib_type at_driveweight;
 
     /* die Zahlen sind genau quivalent zu den race Flags */
 #define MV_CANNOTMOVE     (1<<5)
@@ -63,6 +64,7 @@ extern "C" {
 
     int personcapacity(const struct unit *u);
     void movement(void);
+    void init_transportation(void);
     void run_to(struct unit *u, struct region *to);
     struct unit *is_guarded(struct region *r, struct unit *u, unsigned int mask);
     bool is_guard(const struct unit *u, int mask);
@@ -1,17 +1,26 @@
 #include <kernel/types.h>
 #include <platform.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "move.h"
 
 #include <kernel/ally.h>
 #include <kernel/building.h>
+#include <kernel/config.h>
 #include <kernel/faction.h>
+#include <kernel/messages.h>
+#include <kernel/order.h>
+#include <kernel/race.h>
 #include <kernel/region.h>
 #include <kernel/ship.h>
 #include <kernel/terrain.h>
 #include <kernel/unit.h>
 
+#include <util/attrib.h>
+#include <util/base36.h>
 #include <util/language.h>
+#include <util/message.h>
 
 #include <CuTest.h>
 #include <tests.h>
@@ -168,6 +177,151 @@ static void test_building_type_exists(CuTest * tc)
     CuAssertTrue(tc, !buildingtype_exists(r, btype2, false));
 }
 
+static void setup_transport(void)
+{
+    test_cleanup();
+    test_create_world();
+    test_create_race("human")->weight = 1000;
+    if (!find_argtype("unit"))
+        register_argtype("unit", NULL, NULL, VAR_VOIDPTR);
+    if (!find_argtype("region"))
+        register_argtype("region", NULL, NULL, VAR_VOIDPTR);
+    if (!find_argtype("order"))
+        register_argtype("order", NULL, NULL, VAR_VOIDPTR);
+    if (!mt_find("error286")) {
+        mt_register(mt_new_va("error286", "unit:unit", "region:region",
+            "command:order", NULL));
+    }
+}
+
+static void transport_order(unit *u, const char *targets)
+{
+    unit_addorder(u, create_order(K_TRANSPORT, u->faction->locale, targets));
+}
+
+static void drive_order(unit *u, const unit *carrier)
+{
+    u->thisorder = create_order(K_DRIVE, u->faction->locale, "%s",
+        itoa36(carrier->no));
+}
+
+static int count_errors(const faction *f, const unit *u, const char *name)
+{
+    struct mlist *ml;
+    int n = 0;
+    for (ml = f->msgs ? f->msgs->begin : NULL; ml; ml = ml->next) {
+        if (strcmp(ml->msg->type->name, name) == 0
+            && ml->msg->parameters[0].v == u) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+static int driveweight(const unit *u)
+{
+    attrib *a = a_find(u->attribs, &at_driveweight);
+    return a ? a->data.i : 0;
+}
+
+static void test_drive_first_transport_unit(CuTest * tc)
+{
+    faction *f;
+    unit *carrier, *d1, *d2;
+    char targets[32];
+
+    setup_transport();
+    f = test_create_faction(0);
+    carrier = test_create_unit(f, findregion(0, 0));
+    d1 = test_create_unit(f, carrier->region);
+    d2 = test_create_unit(f, carrier->region);
+    sprintf(targets, "%s", itoa36(d1->no));
+    sprintf(targets + strlen(targets), " %s", itoa36(d2->no));
+    transport_order(carrier, targets);
+    drive_order(d1, carrier);
+    drive_order(d2, carrier);
+
+    init_transportation();
+    /* only the first unit of a TRANSPORT order answers a DRIVE */
+    CuAssertIntEquals(tc, 0, count_errors(f, d1, "error286"));
+    CuAssertIntEquals(tc, 1, count_errors(f, d2, "error286"));
+    CuAssertIntEquals(tc, weight(d1) + weight(d2), driveweight(carrier));
+    test_cleanup();
+}
+
+static void test_drive_not_transported(CuTest * tc)
+{
+    faction *f;
+    unit *carrier, *driver, *other;
+
+    setup_transport();
+    f = test_create_faction(0);
+    carrier = test_create_unit(f, findregion(0, 0));
+    driver = test_create_unit(f, carrier->region);
+    other = test_create_unit(f, carrier->region);
+    transport_order(carrier, itoa36(other->no));
+    drive_order(driver, carrier);
+
+    init_transportation();
+    CuAssertIntEquals(tc, 1, count_errors(f, driver, "error286"));
+    CuAssertIntEquals(tc, 0, driveweight(carrier));
+    test_cleanup();
+}
+
+static void test_drive_at_sea(CuTest * tc)
+{
+    faction *f;
+    region *r;
+    unit *carrier, *driver;
+
+    setup_transport();
+    for (r = regions; r && !fval(r->terrain, SEA_REGION); r = r->next);
+    CuAssertPtrNotNull(tc, r);
+    f = test_create_faction(0);
+    carrier = test_create_unit(f, r);
+    driver = test_create_unit(f, r);
+    transport_order(carrier, itoa36(driver->no));
+    drive_order(driver, carrier);
+
+    init_transportation();
+    CuAssertIntEquals(tc, 1, count_errors(f, driver, "error286"));
+    CuAssertIntEquals(tc, 0, driveweight(carrier));
+    test_cleanup();
+}
+
+static void test_driveweight(CuTest * tc)
+{
+    faction *f;
+    unit *carrier, *d1, *d2, *d3;
+    char targets[32];
+
+    setup_transport();
+    f = test_create_faction(0);
+    carrier = test_create_unit(f, findregion(0, 0));
+    d1 = test_create_unit(f, carrier->region);
+    d2 = test_create_unit(f, carrier->region);
+    d3 = test_create_unit(f, carrier->region);
+    scale_number(d2, 2);
+    scale_number(d3, 3);
+    sprintf(targets, "%s", itoa36(d1->no));
+    sprintf(targets + strlen(targets), " %s", itoa36(d2->no));
+    sprintf(targets + strlen(targets), " %s", itoa36(d1->no));
+    transport_order(carrier, targets);
+    transport_order(carrier, itoa36(d3->no));
+    drive_order(d1, carrier);
+    drive_order(d2, carrier);
+    drive_order(d3, carrier);
+
+    init_transportation();
+    CuAssertTrue(tc, weight(d1) > 0);
+    CuAssertIntEquals(tc, 0, count_errors(f, d1, "error286"));
+    CuAssertIntEquals(tc, 0, count_errors(f, d3, "error286"));
+    /* a driver that is listed twice is counted twice */
+    CuAssertIntEquals(tc, 2 * weight(d1) + weight(d2) + weight(d3),
+        driveweight(carrier));
+    test_cleanup();
+}
+
 CuSuite *get_move_suite(void)
 {
     CuSuite *suite = CuSuiteNew();
@@ -178,5 +332,9 @@ CuSuite *get_move_suite(void)
     SUITE_ADD_TEST(suite, test_ship_has_harbormaster_contact);
     SUITE_ADD_TEST(suite, test_ship_has_harbormaster_ally);
     SUITE_ADD_TEST(suite, test_ship_has_harbormaster_same_faction);
+    SUITE_ADD_TEST(suite, test_drive_first_transport_unit);
+    SUITE_ADD_TEST(suite, test_drive_not_transported);
+    SUITE_ADD_TEST(suite, test_drive_at_sea);
+    SUITE_ADD_TEST(suite, test_driveweight);
     return suite;
 }
@@ -1115,12 +1115,8 @@ static void demon_skillchanges(void)
 
         if (fval(u, UFL_HUNGER)) {
           /* hungry demons only go down, never up in skill */
-          static int rule_hunger = -1;
-          if (rule_hunger < 0) {
-            rule_hunger =
-              get_param_int(global.parameters, "hunger.demon.skill", 0);
-          }
-          if (rule_hunger) {
+          static rule_int rule_hunger = RULE_INT("hunger.demon.skill", 0);
+          if (rule_get_int(&rule_hunger)) {
             upchance = 0;
             downchance = 15;
           }
@@ -1171,13 +1167,10 @@ static void icebergs(void)
 #ifdef HERBS_ROT
 static void rotting_herbs(void)
 {
-    static int rule_rot = -1;
+    static rule_int rule_herbrot = RULE_INT("rules.economy.herbrot", HERBROTCHANCE);
+    int rule_rot = rule_get_int(&rule_herbrot);
     region *r;
 
-    if (rule_rot < 0) {
-        rule_rot =
-            get_param_int(global.parameters, "rules.economy.herbrot", HERBROTCHANCE);
-    }
     if (rule_rot == 0) return;
 
     for (r = regions; r; r = r->next) {
@@ -1128,72 +1128,121 @@ static void get_addresses(report_context * ctx)
     ctx->addresses = flist;
 }
 
-#define MAXSEEHASH 0x1000
-seen_region *reuse;
-
-seen_region **seen_init(void)
+/* seen regions are kept in pages of SEEN_PAGESIZE entries, indexed by
+ * region::index. the page table grows with the number of regions, and
+ * only pages that contain a seen region are allocated. since regions are
+ * numbered in the order of the region list, walking the pages visits
+ * them in that order, too. */
+#define SEEN_PAGEBITS 6
+#define SEEN_PAGESIZE (1 << SEEN_PAGEBITS)
+
+typedef struct seen_data {
+    seen_region **pages;
+    unsigned int maxpages;
+} seen_data;
+
+static seen_region *reuse;      /* free pages, linked by their first next */
+
+seen_data *seen_init(void)
 {
-    return (seen_region **)calloc(MAXSEEHASH, sizeof(seen_region *));
+    return (seen_data *)calloc(1, sizeof(seen_data));
 }
 
-void seen_done(seen_region * seehash[])
+void seen_done(seen_data * seen)
 {
-    int i;
-    for (i = 0; i != MAXSEEHASH; ++i) {
-        seen_region *sd = seehash[i];
-        if (sd == NULL)
-            continue;
-        while (sd->nextHash != NULL)
-            sd = sd->nextHash;
-        sd->nextHash = reuse;
-        reuse = seehash[i];
-        seehash[i] = NULL;
+    unsigned int p;
+    for (p = 0; p != seen->maxpages; ++p) {
+        seen_region *page = seen->pages[p];
+        if (page != NULL) {
+            page->next = reuse;
+            reuse = page;
+            seen->pages[p] = NULL;
+        }
     }
-    /*  free(seehash); */
+}
+
+void seen_free(seen_data * seen)
+{
+    seen_done(seen);
+    free(seen->pages);
+    free(seen);
 }
 
 void free_seen(void)
 {
     while (reuse) {
-        seen_region *r = reuse;
-        reuse = reuse->nextHash;
-        free(r);
+        seen_region *page = reuse;
+        reuse = reuse->next;
+        free(page);
     }
 }
 
+static seen_region *new_page(void)
+{
+    seen_region *page = reuse;
+    if (page) {
+        reuse = page->next;
+        memset(page, 0, sizeof(seen_region) * SEEN_PAGESIZE);
+    }
+    else {
+        page = (seen_region *)calloc(SEEN_PAGESIZE, sizeof(seen_region));
+    }
+    return page;
+}
+
+/* calls cb for each seen region in [first, last), in region order */
+static void
+foreach_seen(seen_data * seen, const region * first, const region * last,
+    void(*cb)(seen_region *, void *), void *cbdata)
+{
+    unsigned int p = first->index >> SEEN_PAGEBITS;
+    for (; p < seen->maxpages; ++p) {
+        seen_region *page = seen->pages[p];
+        if (page != NULL) {
+            int i;
+            for (i = 0; i != SEEN_PAGESIZE; ++i) {
+                seen_region *sr = page + i;
+                if (sr->r) {
+                    if (last && sr->r->index >= last->index) {
+                        return;
+                    }
+                    if (sr->r->index >= first->index) {
+                        cb(sr, cbdata);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void cb_link_seen(seen_region *sr, void *cbdata)
+{
+    seen_region ***tail = (seen_region ***)cbdata;
+    **tail = sr;
+    *tail = &sr->next;
+}
+
 void
-link_seen(seen_region * seehash[], const region * first, const region * last)
+link_seen(seen_data * seen, const region * first, const region * last)
 {
-    const region *r = first;
-    seen_region *sr = NULL;
+    seen_region *list = NULL;
+    seen_region **tail = &list;
 
     if (first == last)
         return;
 
-    do {
-        sr = find_seen(seehash, r);
-        r = r->next;
-    } while (sr == NULL && r != last);
-
-    while (r != last) {
-        seen_region *sn = find_seen(seehash, r);
-        if (sn != NULL) {
-            sr->next = sn;
-            sr = sn;
-        }
-        r = r->next;
-    }
-    sr->next = 0;
+    foreach_seen(seen, first, last, cb_link_seen, &tail);
+    *tail = NULL;
 }
 
-seen_region *find_seen(struct seen_region *seehash[], const region * r)
+seen_region *find_seen(struct seen_data *seen, const region * r)
 {
-    unsigned int index = reg_hashkey(r) & (MAXSEEHASH - 1);
-    seen_region *find = seehash[index];
-    while (find) {
-        if (find->r == r)
-            return find;
-        find = find->nextHash;
+    unsigned int p = r->index >> SEEN_PAGEBITS;
+    if (p < seen->maxpages && seen->pages[p]) {
+        seen_region *sr = seen->pages[p] + (r->index & (SEEN_PAGESIZE - 1));
+        if (sr->r == r) {
+            return sr;
+        }
     }
     return NULL;
 }
@@ -1202,35 +1251,48 @@ static void get_seen_interval(report_context * ctx)
 {
     /* this is required to find the neighbour regions of the ones we are in,
      * which may well be outside of [firstregion, lastregion) */
-    int i;
-    for (i = 0; i != MAXSEEHASH; ++i) {
-        seen_region *sr = ctx->seen[i];
-        while (sr != NULL) {
-            if (ctx->first == NULL || sr->r->index < ctx->first->index) {
-                ctx->first = sr->r;
-            }
-            if (ctx->last != NULL && sr->r->index >= ctx->last->index) {
-                ctx->last = sr->r->next;
+    seen_data *seen = ctx->seen;
+    unsigned int p;
+    for (p = 0; p != seen->maxpages; ++p) {
+        seen_region *page = seen->pages[p];
+        if (page != NULL) {
+            int i;
+            for (i = 0; i != SEEN_PAGESIZE; ++i) {
+                seen_region *sr = page + i;
+                if (sr->r == NULL)
+                    continue;
+                if (ctx->first == NULL || sr->r->index < ctx->first->index) {
+                    ctx->first = sr->r;
+                }
+                if (ctx->last != NULL && sr->r->index >= ctx->last->index) {
+                    ctx->last = sr->r->next;
+                }
             }
-            sr = sr->nextHash;
         }
     }
     link_seen(ctx->seen, ctx->first, ctx->last);
 }
 
 bool
-add_seen(struct seen_region *seehash[], struct region *r, unsigned char mode,
+add_seen(struct seen_data *seen, struct region *r, unsigned char mode,
 bool dis)
 {
-    seen_region *find = find_seen(seehash, r);
-    if (find == NULL) {
-        unsigned int index = reg_hashkey(r) & (MAXSEEHASH - 1);
-        if (!reuse)
-            reuse = (seen_region *)calloc(1, sizeof(struct seen_region));
-        find = reuse;
-        reuse = reuse->nextHash;
-        find->nextHash = seehash[index];
-        seehash[index] = find;
+    unsigned int p = r->index >> SEEN_PAGEBITS;
+    seen_region *find;
+    if (p >= seen->maxpages) {
+        unsigned int maxpages = seen->maxpages ? seen->maxpages : 64;
+        while (maxpages <= p) {
+            maxpages *= 2;
+        }
+        seen->pages = (seen_region **)realloc(seen->pages, sizeof(seen_region *) * maxpages);
+        memset(seen->pages + seen->maxpages, 0, sizeof(seen_region *) * (maxpages - seen->maxpages));
+        seen->maxpages = maxpages;
+    }
+    if (seen->pages[p] == NULL) {
+        seen->pages[p] = new_page();
+    }
+    find = seen->pages[p] + (r->index & (SEEN_PAGESIZE - 1));
+    if (find->r == NULL) {
         find->r = r;
     }
     else if (find->mode >= mode) {
@@ -1260,6 +1322,21 @@ void register_reporttype(const char *extension, report_fun write, int flag)
     report_types = type;
 }
 
+void unregister_reporttype(const char *extension)
+{
+    report_type **tp = &report_types;
+    while (*tp) {
+        report_type *type = *tp;
+        if (strcmp(type->extension, extension) == 0) {
+            *tp = type->next;
+            free(type);
+        }
+        else {
+            tp = &type->next;
+        }
+    }
+}
+
 static quicklist *get_regions_distance(region * root, int radius)
 {
     quicklist *ql, *rlist = NULL;
@@ -1290,7 +1367,7 @@ static quicklist *get_regions_distance(region * root, int radius)
     return rlist;
 }
 
-static void view_default(struct seen_region **seen, region * r, faction * f)
+static void view_default(struct seen_data *seen, region * r, faction * f)
 {
     int dir;
     for (dir = 0; dir != MAXDIRECTIONS; ++dir) {
@@ -1308,7 +1385,7 @@ static void view_default(struct seen_region **seen, region * r, faction * f)
     }
 }
 
-static void view_neighbours(struct seen_region **seen, region * r, faction * f)
+static void view_neighbours(struct seen_data *seen, region * r, faction * f)
 {
     int d;
     region * nb[MAXDIRECTIONS];
@@ -1348,7 +1425,7 @@ static void view_neighbours(struct seen_region **seen, region * r, faction * f)
 }
 
 static void
-recurse_regatta(struct seen_region **seen, region * center, region * r,
+recurse_regatta(struct seen_data *seen, region * center, region * r,
 faction * f, int maxdist)
 {
     int d;
@@ -1381,7 +1458,7 @@ faction * f, int maxdist)
     }
 }
 
-static void view_regatta(struct seen_region **seen, region * r, faction * f)
+static void view_regatta(struct seen_data *seen, region * r, faction * f)
 {
     unit *u;
     int skill = 0;
@@ -1526,7 +1603,7 @@ static void prepare_reports(void)
 
     for (f = factions; f; f = f->next) {
         if (f->seen) seen_done(f->seen);
-        f->seen = seen_init();
+        else f->seen = seen_init();
     }
 
     for (r = regions; r; r = r->next) {
@@ -1597,7 +1674,7 @@ static void prepare_reports(void)
     }
 }
 
-static seen_region **prepare_report(faction * f)
+static seen_data *prepare_report(faction * f)
 {
     struct seen_region *sr;
     region *r = firstregion(f);
@@ -1613,7 +1690,7 @@ static seen_region **prepare_report(faction * f)
         if (sr->mode > see_neighbour) {
             region *r = sr->r;
             plane *p = rplane(r);
-            void(*view) (struct seen_region **, region *, faction *) = view_default;
+            void(*view) (struct seen_data *, region *, faction *) = view_default;
 
             if (p && fval(p, PFL_SEESPECIAL)) {
                 /* TODO: this is not very customizable */
@@ -1776,32 +1853,46 @@ int init_reports(void)
     return 0;
 }
 
-int reports(void)
+/** writes the reports for one part of the factions.
+ * the factions are split into parts by their number, so several processes
+ * that have read the same game can write the reports for one turn side by
+ * side, each with a different part. the first part also writes reports.txt
+ * for all factions, and the global report.
+ */
+int reports_partition(int part, int parts)
 {
     faction *f;
-    FILE *mailit;
+    FILE *mailit = NULL;
     time_t ltime = time(NULL);
     int retval = 0;
     char path[MAX_PATH];
 
+    assert(parts > 0 && part >= 0 && part < parts);
+
     if (verbosity >= 1) {
         log_printf(stdout, "Writing reports for turn %d:", turn);
     }
     nmr_warnings();
     report_donations();
     remove_empty_units();
+    cansee_index(true);
+    skill_cache(true);
 
     _mkdir(reportpath());
-    sprintf(path, "%s/reports.txt", reportpath());
-    mailit = fopen(path, "w");
-    if (mailit == NULL) {
-        log_error("%s could not be opened!\n", path);
+    if (part == 0) {
+        sprintf(path, "%s/reports.txt", reportpath());
+        mailit = fopen(path, "w");
+        if (mailit == NULL) {
+            log_error("%s could not be opened!\n", path);
+        }
     }
 
     for (f = factions; f; f = f->next) {
-        int error = write_reports(f, ltime);
-        if (error)
-            retval = error;
+        if (f->no % parts == part) {
+            int error = write_reports(f, ltime);
+            if (error)
+                retval = error;
+        }
         if (mailit)
             write_script(mailit, f);
     }
@@ -1809,7 +1900,7 @@ int reports(void)
         fclose(mailit);
     free_seen();
 #ifdef GLOBAL_REPORT
-    {
+    if (part == 0) {
         const char *str = get_param(global.parameters, "globalreport");
         if (str != NULL) {
             sprintf(path, "%s/%s.%u.cr", reportpath(), str, turn);
@@ -1817,9 +1908,16 @@ int reports(void)
         }
     }
 #endif
+    skill_cache(false);
+    cansee_index(false);
     return retval;
 }
 
+int reports(void)
+{
+    return reports_partition(0, 1);
+}
+
 static variant var_copy_string(variant x)
 {
     x.v = x.v ? _strdup((const char *)x.v) : 0;
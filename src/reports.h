@@ -52,6 +52,7 @@ extern "C" {
         const struct unit *u, int indent, int mode);
 
     int reports(void);
+    int reports_partition(int part, int parts);
     int write_reports(struct faction *f, time_t ltime);
     int init_reports(void);
     void reorder_units(struct region * r);
@@ -71,27 +72,29 @@ extern "C" {
     int stealth_modifier(int seen_mode);
 
     typedef struct seen_region {
-        struct seen_region *nextHash;
         struct seen_region *next;
         struct region *r;
         unsigned char mode;
         bool disbelieves;
     } seen_region;
 
-    struct seen_region *find_seen(struct seen_region *seehash[],
+    struct seen_data;
+
+    struct seen_region *find_seen(struct seen_data *seen,
         const struct region *r);
-    bool add_seen(struct seen_region *seehash[], struct region *r,
+    bool add_seen(struct seen_data *seen, struct region *r,
         unsigned char mode, bool dis);
-    struct seen_region **seen_init(void);
-    void seen_done(struct seen_region *seehash[]);
+    struct seen_data *seen_init(void);
+    void seen_done(struct seen_data *seen);
+    void seen_free(struct seen_data *seen);
     void free_seen(void);
-    void link_seen(seen_region * seehash[], const struct region *first,
+    void link_seen(struct seen_data *seen, const struct region *first,
         const struct region *last);
 
     typedef struct report_context {
         struct faction *f;
         struct quicklist *addresses;
-        struct seen_region **seen;
+        struct seen_data *seen;
         struct region *first, *last;
         void *userdata;
         time_t report_time;
@@ -101,6 +104,7 @@ extern "C" {
         const char *charset);
     void register_reporttype(const char *extension, report_fun write,
         int flag);
+    void unregister_reporttype(const char *extension);
 
     int bufunit(const struct faction *f, const struct unit *u, int indent,
         int mode, char *buf, size_t size);
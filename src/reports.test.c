@@ -1,4 +1,6 @@
+#include <platform.h>
 #include <config.h>
+#include <kernel/config.h>
 #include <kernel/types.h>
 #include "reports.h"
 
@@ -14,6 +16,7 @@
 #include <CuTest.h>
 #include <tests.h>
 
+#include <stdio.h>
 #include <string.h>
 
 static void test_reorder_units(CuTest * tc)
@@ -98,11 +101,99 @@ static void test_seen_faction(CuTest *tc) {
     CuAssertTrue(tc, f1->no<f2->no);
 }
 
+static void test_seen_regions(CuTest *tc) {
+    region *r1, *r2, *r3;
+    struct seen_data *seen;
+    seen_region *sr;
+
+    test_cleanup();
+    r1 = test_create_region(0, 0, 0);
+    r2 = test_create_region(1, 0, 0);
+    r3 = test_create_region(2, 0, 0);
+    seen = seen_init();
+    CuAssertPtrEquals(tc, 0, find_seen(seen, r1));
+    CuAssertTrue(tc, add_seen(seen, r3, see_neighbour, false));
+    CuAssertTrue(tc, add_seen(seen, r1, see_unit, false));
+    CuAssertTrue(tc, !add_seen(seen, r1, see_far, true));
+    CuAssertTrue(tc, add_seen(seen, r3, see_far, false));
+    CuAssertPtrEquals(tc, 0, find_seen(seen, r2));
+    sr = find_seen(seen, r1);
+    CuAssertPtrNotNull(tc, sr);
+    CuAssertIntEquals(tc, see_unit, sr->mode);
+    CuAssertTrue(tc, !sr->disbelieves);
+
+    link_seen(seen, r1, NULL);
+    CuAssertPtrEquals(tc, r3, sr->next->r);
+    CuAssertIntEquals(tc, see_far, sr->next->mode);
+    CuAssertPtrEquals(tc, 0, sr->next->next);
+    link_seen(seen, r1, r3);
+    CuAssertPtrEquals(tc, 0, sr->next);
+
+    seen_done(seen);
+    CuAssertPtrEquals(tc, 0, find_seen(seen, r1));
+    seen_free(seen);
+    free_seen();
+    test_cleanup();
+}
+
+#define TEST_FACTIONS 7
+static faction *partition_factions[TEST_FACTIONS];
+static int partition_reports[TEST_FACTIONS];
+
+static int count_report(const char *filename, report_context *ctx, const char *charset)
+{
+    int i;
+    for (i = 0; i != TEST_FACTIONS; ++i) {
+        if (partition_factions[i] == ctx->f) {
+            ++partition_reports[i];
+        }
+    }
+    return 0;
+}
+
+static void test_reports_partition(CuTest *tc) {
+    const int flag = 1 << 30;
+    char path[MAX_PATH];
+    region *r;
+    int i, part;
+
+    test_cleanup();
+    /* write reports.txt next to the test data, not into reports/ */
+    strcpy(path, datapath());
+    set_reportpath(path);
+    test_create_world();
+    test_create_buildingtype("lighthouse");
+    r = findregion(0, 0);
+    register_reporttype("test", count_report, flag);
+    for (i = 0; i != TEST_FACTIONS; ++i) {
+        faction *f = test_create_faction(0);
+        f->options = flag;
+        test_create_unit(f, r);
+        partition_factions[i] = f;
+        partition_reports[i] = 0;
+    }
+    CuAssertIntEquals(tc, 0, init_reports());
+    for (part = 0; part != 3; ++part) {
+        CuAssertIntEquals(tc, 0, reports_partition(part, 3));
+    }
+    for (i = 0; i != TEST_FACTIONS; ++i) {
+        CuAssertIntEquals(tc, 1, partition_reports[i]);
+    }
+    unregister_reporttype("test");
+    strcat(path, "/reports.txt");
+    CuAssertIntEquals(tc, 0, remove(path));
+    set_reportpath(NULL);
+    memset(partition_factions, 0, sizeof(partition_factions));
+    test_cleanup();
+}
+
 CuSuite *get_reports_suite(void)
 {
   CuSuite *suite = CuSuiteNew();
   SUITE_ADD_TEST(suite, test_reorder_units);
   SUITE_ADD_TEST(suite, test_seen_faction);
+  SUITE_ADD_TEST(suite, test_seen_regions);
+  SUITE_ADD_TEST(suite, test_reports_partition);
   SUITE_ADD_TEST(suite, test_regionid);
   return suite;
 }
@@ -3740,7 +3740,7 @@ static int sp_rallypeasantmob(castorder * co)
         }
     }
 
-    c = get_curse(r->attribs, ct_find(oldcursename(C_RIOT)));
+    c = get_curse(r->attribs, oldcursetype(C_RIOT));
     if (c != NULL) {
         remove_curse(&r->attribs, c);
     }
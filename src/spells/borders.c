@@ -67,7 +67,7 @@ static int cw_read(attrib * a, void *target, storage * store)
   ur_add(var, &wc->wall, resolve_borderid);
 
   var.v = br;
-  ur_add(var, &wc->buddy, resolve_buddy);
+  ur_add_ptr(var, &wc->buddy, resolve_buddy);
   return AT_READ_OK;
 }
 
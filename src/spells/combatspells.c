@@ -1580,6 +1580,12 @@ int sp_reanimate(struct castorder * co)
   if (j <= 0) {
     level = j;
   }
+  else {
+    /* the dead are back among the living */
+    b->fast.alive = -1;
+    b->rowcache.alive = -1;
+    b->selectcache.alive = -1;
+  }
   if (use_item) {
     msg =
       msg_message("reanimate_effect_1", "mage amount item", mage, j,
@@ -530,6 +530,11 @@ static double study_speedup(unit * u, skill_t s, study_rule_t rule)
     return 1.0;
 }
 
+static int parse_newskills(const char *str, int def)
+{
+    return (str && strcmp(str, "false") == 0) ? 0 : 1;
+}
+
 int learn_cmd(unit * u, order * ord)
 {
     region *r = u->region;
@@ -543,15 +548,10 @@ int learn_cmd(unit * u, order * ord)
     int money = 0;
     skill_t sk;
     int maxalchemy = 0;
-    int speed_rule = (study_rule_t)get_param_int(global.parameters, "study.speedup", 0);
-    static int learn_newskills = -1;
-    if (learn_newskills < 0) {
-        const char *str = get_param(global.parameters, "study.newskills");
-        if (str && strcmp(str, "false") == 0)
-            learn_newskills = 0;
-        else
-            learn_newskills = 1;
-    }
+    static rule_int rule_speedup = RULE_INT("study.speedup", 0);
+    static rule_int rule_newskills = RULE_PARSE("study.newskills", 1, parse_newskills);
+    int speed_rule = (study_rule_t)rule_get_int(&rule_speedup);
+    int learn_newskills = rule_get_int(&rule_newskills);
     if ((u_race(u)->flags & RCF_NOLEARN) || fval(u, UFL_WERE)) {
         ADDMSG(&u->faction->msgs, msg_feedback(u, ord, "error_race_nolearn", "race",
             u_race(u)));
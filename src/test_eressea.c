@@ -33,7 +33,10 @@ int RunAllTests(void)
   ADD_TESTS(suite, attrib);
   ADD_TESTS(suite, base36);
   ADD_TESTS(suite, bsdstring);
+  ADD_TESTS(suite, event);
   ADD_TESTS(suite, functions);
+  ADD_TESTS(suite, resolve);
+  ADD_TESTS(suite, translation);
   ADD_TESTS(suite, umlaut);
   ADD_TESTS(suite, unicode);
   ADD_TESTS(suite, strings);
@@ -41,11 +44,14 @@ int RunAllTests(void)
   ADD_TESTS(suite, unit);
   ADD_TESTS(suite, faction);
   ADD_TESTS(suite, build);
+  ADD_TESTS(suite, connection);
   ADD_TESTS(suite, pool);
+  ADD_TESTS(suite, pathfinder);
   ADD_TESTS(suite, curse);
   ADD_TESTS(suite, equipment);
   ADD_TESTS(suite, item);
   ADD_TESTS(suite, magic);
+  ADD_TESTS(suite, messages);
   ADD_TESTS(suite, reports);
   ADD_TESTS(suite, save);
   ADD_TESTS(suite, ship);
@@ -117,13 +117,8 @@ void get_food(region * r)
     plane *pl = rplane(r);
     unit *u;
     int peasantfood = rpeasants(r) * 10;
-    static int food_rules = -1;
-    static int gamecookie = -1;
-
-    if (food_rules < 0 || gamecookie != global.cookie) {
-        gamecookie = global.cookie;
-        food_rules = get_param_int(global.parameters, "rules.economy.food", 0);
-    }
+    static rule_int rule_food = RULE_INT("rules.economy.food", 0);
+    int food_rules = rule_get_int(&rule_food);
 
     if (food_rules & FOOD_IS_FREE) {
         return;
@@ -281,11 +276,8 @@ void get_food(region * r)
                     peasantfood = 0;
                 }
                 if (hungry > 0) {
-                    static int demon_hunger = -1;
-                    if (demon_hunger < 0) {
-                        demon_hunger = get_param_int(global.parameters, "hunger.demons", 0);
-                    }
-                    if (demon_hunger == 0) {
+                    static rule_int rule_hunger = RULE_INT("hunger.demons", 0);
+                    if (rule_get_int(&rule_hunger) == 0) {
                         /* demons who don't feed are hungry */
                         if (hunger(hungry, u))
                             fset(u, UFL_HUNGER);
@@ -115,21 +115,78 @@ int handle_triggers(trigger ** triggers, void *param)
  ** at_eventhandler
  **/
 
+/* event names are interned, so handlers can be matched by number instead
+ * of strcmp. the name is what goes into the savefile. callers that raise
+ * the same event for many objects can look up its id once with event_id()
+ * and use handle_event_id(). for every event, we count the handlers that
+ * exist in the whole game, and handle_event_id() returns at once for
+ * events that nobody is listening to.
+ */
+typedef struct event_info {
+  char *name;
+  int handlers;
+} event_info;
+
+static event_info *events;
+static int num_events, max_events;
+
+static int event_find(const char *name)
+{
+  int i;
+  for (i = 0; i != num_events; ++i) {
+    if (strcmp(events[i].name, name) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int event_id(const char *name)
+{
+  int i = event_find(name);
+  if (i < 0) {
+    if (num_events == max_events) {
+      max_events = max_events ? max_events * 2 : 16;
+      events = (event_info *)realloc(events, max_events * sizeof(event_info));
+    }
+    i = num_events++;
+    events[i].name = _strdup(name);
+    events[i].handlers = 0;
+  }
+  return i;
+}
+
+int event_handlers(int id)
+{
+  assert(id >= 0 && id < num_events);
+  return events[id].handlers;
+}
+
 typedef struct handler_info {
-  char *event;
+  int event;                    /* index into events */
   trigger *triggers;
 } handler_info;
 
+static void handler_set_event(handler_info * hi, const char *name)
+{
+  hi->event = event_id(name);
+  ++events[hi->event].handlers;
+}
+
 static void init_handler(attrib * a)
 {
-  a->data.v = calloc(sizeof(handler_info), 1);
+  handler_info *hi = (handler_info *)calloc(sizeof(handler_info), 1);
+  hi->event = -1;
+  a->data.v = hi;
 }
 
 static void free_handler(attrib * a)
 {
   handler_info *hi = (handler_info *) a->data.v;
   free_triggers(hi->triggers);
-  free(hi->event);
+  if (hi->event >= 0) {
+    --events[hi->event].handlers;
+  }
   free(hi);
 }
 
@@ -137,7 +194,7 @@ static void
 write_handler(const attrib * a, const void *owner, struct storage *store)
 {
   handler_info *hi = (handler_info *) a->data.v;
-  WRITE_TOK(store, hi->event);
+  WRITE_TOK(store, events[hi->event].name);
   write_triggers(store, hi->triggers);
 }
 
@@ -147,7 +204,7 @@ static int read_handler(attrib * a, void *owner, struct storage *store)
   handler_info *hi = (handler_info *) a->data.v;
 
   READ_TOK(store, zText, sizeof(zText));
-  hi->event = _strdup(zText);
+  handler_set_event(hi, zText);
   read_triggers(store, &hi->triggers);
   if (hi->triggers != NULL) {
     return AT_READ_OK;
@@ -167,10 +224,16 @@ attrib_type at_eventhandler = {
 struct trigger **get_triggers(struct attrib *ap, const char *eventname)
 {
   handler_info *td = NULL;
-  attrib *a = a_find(ap, &at_eventhandler);
+  attrib *a;
+  int id = event_find(eventname);
+
+  if (id < 0 || events[id].handlers == 0) {
+    return NULL;
+  }
+  a = a_find(ap, &at_eventhandler);
   while (a != NULL && a->type == &at_eventhandler) {
     td = (handler_info *) a->data.v;
-    if (strcmp(td->event, eventname) == 0) {
+    if (td->event == id) {
       return &td->triggers;
     }
     a = a->next;
@@ -183,10 +246,11 @@ void add_trigger(struct attrib **ap, const char *eventname, struct trigger *t)
   trigger **tp;
   handler_info *td = NULL;
   attrib *a = a_find(*ap, &at_eventhandler);
+  int id = event_id(eventname);
   assert(t->next == NULL);
   while (a != NULL && a->type == &at_eventhandler) {
     td = (handler_info *) a->data.v;
-    if (!strcmp(td->event, eventname)) {
+    if (td->event == id) {
       break;
     }
     a = a->next;
@@ -194,7 +258,7 @@ void add_trigger(struct attrib **ap, const char *eventname, struct trigger *t)
   if (a == NULL || a->type != &at_eventhandler) {
     a = a_add(ap, a_new(&at_eventhandler));
     td = (handler_info *) a->data.v;
-    td->event = _strdup(eventname);
+    handler_set_event(td, eventname);
   }
   tp = &td->triggers;
   while (*tp)
@@ -202,8 +266,12 @@ void add_trigger(struct attrib **ap, const char *eventname, struct trigger *t)
   *tp = t;
 }
 
-void handle_event(attrib * attribs, const char *eventname, void *data)
+void handle_event_id(attrib * attribs, int id, void *data)
 {
+  assert(id >= 0 && id < num_events);
+  if (!attribs || events[id].handlers == 0) {
+    return;
+  }
   while (attribs) {
     if (attribs->type == &at_eventhandler)
       break;
@@ -211,8 +279,7 @@ void handle_event(attrib * attribs, const char *eventname, void *data)
   }
   while (attribs && attribs->type == &at_eventhandler) {
     handler_info *tl = (handler_info *) attribs->data.v;
-    if (!strcmp(tl->event, eventname)) {
-      handler_info *tl = (handler_info *) attribs->data.v;
+    if (tl->event == id) {
       handle_triggers(&tl->triggers, data);
       break;
     }
@@ -220,6 +287,19 @@ void handle_event(attrib * attribs, const char *eventname, void *data)
   }
 }
 
+void handle_event(attrib * attribs, const char *eventname, void *data)
+{
+  int id;
+
+  if (!attribs) {
+    return;
+  }
+  id = event_find(eventname);
+  if (id >= 0) {
+    handle_event_id(attribs, id, data);
+  }
+}
+
 void t_add(struct trigger **tlist, struct trigger *t)
 {
   while (*tlist)
@@ -69,6 +69,11 @@ extern "C" {
 /* calls handle() for each of these. e.g. used in timeout */
   extern void handle_event(struct attrib *attribs, const char *eventname,
     void *data);
+/* the same, for an event id from event_id(). ids stay valid for the
+ * lifetime of the process. */
+  extern int event_id(const char *eventname);
+  extern void handle_event_id(struct attrib *attribs, int id, void *data);
+  extern int event_handlers(int id);    /* number of handlers in the game */
 
 /* functions for making complex triggers: */
   extern void free_triggers(trigger * triggers);        /* release all these triggers */
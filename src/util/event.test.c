@@ -0,0 +1,87 @@
+#include <platform.h>
+#include <CuTest.h>
+#include "event.h"
+#include "attrib.h"
+
+#include <stdlib.h>
+
+static int handled;
+
+static int count_handle(trigger * t, void *data)
+{
+  handled += *(int *)data;
+  return 0;
+}
+
+static void count_finalize(trigger * t)
+{
+  free(t);
+}
+
+static trigger_type tt_count = {
+  "count",
+  NULL,
+  count_finalize,
+  count_handle
+};
+
+static void test_handle_event(CuTest * tc)
+{
+  attrib *attribs = NULL;
+  int value = 3;
+
+  handled = 0;
+  handle_event(attribs, "tick", &value);
+  CuAssertPtrEquals(tc, NULL, get_triggers(attribs, "tick"));
+  add_trigger(&attribs, "tick", t_new(&tt_count));
+  add_trigger(&attribs, "tock", t_new(&tt_count));
+  add_trigger(&attribs, "tick", t_new(&tt_count));
+  CuAssertPtrNotNull(tc, get_triggers(attribs, "tick"));
+  CuAssertPtrEquals(tc, NULL, get_triggers(attribs, "tack"));
+  handle_event(attribs, "tick", &value);
+  CuAssertIntEquals(tc, 6, handled);
+  handle_event(attribs, "tock", &value);
+  CuAssertIntEquals(tc, 9, handled);
+  handle_event(attribs, "tack", &value);
+  CuAssertIntEquals(tc, 9, handled);
+  a_removeall(&attribs, &at_eventhandler);
+  handle_event(attribs, "tick", &value);
+  CuAssertIntEquals(tc, 9, handled);
+  CuAssertPtrEquals(tc, NULL, get_triggers(attribs, "tick"));
+}
+
+static void test_event_handlers(CuTest * tc)
+{
+  attrib *attribs = NULL, *other = NULL;
+  int value = 2;
+  int tick = event_id("tick");
+
+  CuAssertIntEquals(tc, tick, event_id("tick"));
+  CuAssertIntEquals(tc, 0, event_handlers(tick));
+  add_trigger(&attribs, "tick", t_new(&tt_count));
+  add_trigger(&attribs, "tick", t_new(&tt_count));
+  CuAssertIntEquals(tc, 1, event_handlers(tick));
+  add_trigger(&other, "tick", t_new(&tt_count));
+  CuAssertIntEquals(tc, 2, event_handlers(tick));
+
+  handled = 0;
+  handle_event_id(attribs, tick, &value);
+  CuAssertIntEquals(tc, 4, handled);
+  handle_event_id(other, tick, &value);
+  CuAssertIntEquals(tc, 6, handled);
+
+  a_removeall(&attribs, &at_eventhandler);
+  CuAssertIntEquals(tc, 1, event_handlers(tick));
+  a_removeall(&other, &at_eventhandler);
+  CuAssertIntEquals(tc, 0, event_handlers(tick));
+  handle_event_id(other, tick, &value);
+  CuAssertIntEquals(tc, 6, handled);
+}
+
+CuSuite *get_event_suite(void)
+{
+  CuSuite *suite = CuSuiteNew();
+  SUITE_ADD_TEST(suite, test_handle_event);
+  SUITE_ADD_TEST(suite, test_event_handlers);
+  return suite;
+}
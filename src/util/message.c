@@ -138,15 +138,17 @@ static void free_arg(const arg_type * atype, variant data)
 message *msg_create(const struct message_type *mtype, variant args[])
 {
   int i;
-  message *msg = (message *) malloc(sizeof(message));
+  message *msg;
 
   assert(mtype != NULL);
   if (mtype == NULL) {
     log_error("Trying to create message with type=0x0\n");
     return NULL;
   }
+  /* parameters live in the same block, right behind the header */
+  msg = (message *) malloc(sizeof(message) + mtype->nparameters * sizeof(variant));
   msg->type = mtype;
-  msg->parameters = (variant *) calloc(mtype->nparameters, sizeof(variant));
+  msg->parameters = (variant *)(msg + 1);
   msg->refcount = 1;
   for (i = 0; i != mtype->nparameters; ++i) {
     msg->parameters[i] = copy_arg(mtype->types[i], args[i]);
@@ -203,7 +205,6 @@ void msg_free(message * msg)
   for (i = 0; i != msg->type->nparameters; ++i) {
     free_arg(msg->type->types[i], msg->parameters[i]);
   }
-  free((void *)msg->parameters);
   free(msg);
 }
 
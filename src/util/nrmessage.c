@@ -136,6 +136,7 @@ nrt_register(const struct message_type *mtype, const struct locale *lang,
       c += strlen(strcpy(c, mtype->pnames[i]));
     }
     nrt->vars = _strdup(zNames);
+    nrt->compiled = translation_compile(nrt->string, nrt->vars);
   }
 }
 
@@ -146,10 +147,10 @@ nr_render(const struct message *msg, const struct locale *lang, char *buffer,
   struct nrmessage_type *nrt = nrt_find(lang, msg->type);
 
   if (nrt) {
-    const char *m =
-      translate(nrt->string, userdata, nrt->vars, msg->parameters);
-    if (m) {
-      return strlcpy((char *)buffer, m, size);
+    size_t len = 0;
+    if (nrt->compiled && translation_render(nrt->compiled, userdata,
+      msg->parameters, buffer, size, &len)) {
+      return len;
     } else {
       log_error("Couldn't render message %s\n", nrt->mtype->name);
     }
@@ -10,6 +10,7 @@ typedef struct nrmessage_type {
   const struct locale *lang;
   const char *string;
   const char *vars;
+  struct translation *compiled;
   struct nrmessage_type *next;
   int level;
   const char *section;
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <wctype.h>
 #include <memory.h>
+#include <string.h>
 
 #define SPACE_REPLACEMENT '~'
 #define ESCAPE_CHAR       '\\'
@@ -15,6 +16,9 @@
 typedef struct parser_state {
   const char *current_token;
   char *current_cmd;
+  const char *const *tokens;    /* pre-parsed tokens, instead of current_token */
+  void (*release) (void *);     /* lets go of the owner of tokens */
+  void *owner;
   struct parser_state *next;
 } parser_state;
 
@@ -49,38 +53,74 @@ static int eatwhitespace_c(const char **str_p)
   return ret;
 }
 
+static void release_tokens(parser_state * state)
+{
+  if (state->release) {
+    state->release(state->owner);
+  }
+  state->tokens = NULL;
+  state->release = NULL;
+  state->owner = NULL;
+}
+
+static parser_state *new_state(void)
+{
+  parser_state *state = calloc(1, sizeof(parser_state));
+  return state;
+}
+
 void init_tokens_str(const char *initstr, char *cmd)
 {
   if (states == NULL) {
-    states = malloc(sizeof(parser_state));
+    states = new_state();
   }
   else if (states->current_cmd && states->current_cmd!=cmd) {
     free(states->current_cmd);
   }
+  release_tokens(states);
   states->current_cmd = cmd;
   states->current_token = initstr;
 }
 
+void init_tokens_vec(const char *const *tokens, void (*release) (void *),
+  void *owner)
+{
+  if (states == NULL) {
+    states = new_state();
+  }
+  else if (states->current_cmd) {
+    free(states->current_cmd);
+  }
+  release_tokens(states);
+  states->current_cmd = NULL;
+  states->current_token = NULL;
+  states->tokens = tokens;
+  states->release = release;
+  states->owner = owner;
+}
+
 void parser_pushstate(void)
 {
-  parser_state *new_state = malloc(sizeof(parser_state));
-  new_state->current_cmd = NULL;
-  new_state->current_token = NULL;
-  new_state->next = states;
-  states = new_state;
+  parser_state *state = new_state();
+  state->next = states;
+  states = state;
 }
 
 void parser_popstate(void)
 {
-  parser_state *new_state = states->next;
+  parser_state *state = states->next;
   if (states->current_cmd != NULL)
     free(states->current_cmd);
+  release_tokens(states);
   free(states);
-  states = new_state;
+  states = state;
 }
 
 bool parser_end(void)
 {
+    if (states->tokens) {
+        return *states->tokens == NULL;
+    }
     if (states->current_token) {
         eatwhitespace_c(&states->current_token);
         return *states->current_token == 0;
@@ -91,6 +131,12 @@ bool parser_end(void)
 void skip_token(void)
 {
   char quotechar = 0;
+  if (states->tokens) {
+    if (*states->tokens) {
+      ++states->tokens;
+    }
+    return;
+  }
   eatwhitespace_c(&states->current_token);
 
   while (*states->current_token) {
@@ -127,9 +173,8 @@ void skip_token(void)
   }
 }
 
-const char *parse_token(const char **str)
+static const char *parse_token_i(const char **str, char *lbuf)
 {
-  static char lbuf[MAXTOKENSIZE];       /* STATIC_RESULT: used for return, not across calls */
   char *cursor = lbuf;
   char quotechar = 0;
   bool escape = false;
@@ -196,7 +241,55 @@ const char *parse_token(const char **str)
   return lbuf;
 }
 
+const char *parse_token(const char **str)
+{
+  static char lbuf[MAXTOKENSIZE];       /* STATIC_RESULT: used for return, not across calls */
+  return parse_token_i(str, lbuf);
+}
+
+/* splits str into the tokens that getstrtoken() would return, all in one
+ * block of memory that the caller must free(). the result is a NULL
+ * terminated array. unlike parse_token, this uses no static buffer.
+ */
+const char **parse_tokens(const char *str)
+{
+  char lbuf[MAXTOKENSIZE];
+  const char *cursor = str, *prev = str;
+  const char *tok;
+  size_t count = 0, bytes = 0;
+  const char **result;
+  char *strings;
+
+  while (cursor && (tok = parse_token_i(&cursor, lbuf)) != NULL) {
+    ++count;
+    bytes += strlen(tok) + 1;
+    if (cursor == prev) break;  /* illegal UTF8, parse_token is stuck */
+    prev = cursor;
+  }
+  result = (const char **)malloc((count + 1) * sizeof(char *) + bytes);
+  strings = (char *)(result + count + 1);
+  cursor = prev = str;
+  count = 0;
+  while (cursor && (tok = parse_token_i(&cursor, lbuf)) != NULL) {
+    size_t len = strlen(tok) + 1;
+    memcpy(strings, tok, len);
+    result[count++] = strings;
+    strings += len;
+    if (cursor == prev) break;
+    prev = cursor;
+  }
+  result[count] = NULL;
+  return result;
+}
+
 const char *getstrtoken(void)
 {
+  if (states->tokens) {
+    const char *tok = *states->tokens;
+    if (tok) {
+      ++states->tokens;
+    }
+    return tok;
+  }
   return parse_token((const char **)&states->current_token);
 }
@@ -15,6 +15,9 @@ extern "C" {
 #endif
 
   extern void init_tokens_str(const char *initstr, char *cmd);  /* initialize token parsing, take ownership of cmd */
+  extern void init_tokens_vec(const char *const *tokens,
+    void (*release) (void *), void *owner);    /* parse pre-split tokens, release(owner) when done */
+  extern const char **parse_tokens(const char *str);
   extern void skip_token(void);
   extern const char *parse_token(const char **str);
   extern void parser_pushstate(void);
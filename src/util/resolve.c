@@ -19,7 +19,9 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include <platform.h>
 #include <assert.h>
 #include <stdlib.h>
+#include <time.h>
 #include "resolve.h"
+#include "log.h"
 #include "storage.h"
 #include "variant.h"
 
@@ -30,6 +32,10 @@ typedef struct unresolved {
   /* information on how to resolve the missing object */
   resolve_fun resolve;
   /* function to resolve the unknown object */
+  const char *name;
+  /* name of the resolve function, for the log */
+  bool intkey;
+  /* data.i is an id that entries can be sorted by */
 } unresolved;
 
 #define BLOCKSIZE 1024
@@ -45,18 +51,19 @@ variant read_int(struct storage *store)
 }
 
 int
-read_reference(void *address, storage * store, read_fun reader,
-  resolve_fun resolver)
+read_reference_i(void *address, storage * store, read_fun reader,
+  resolve_fun resolver, const char *name)
 {
   variant var = reader(store);
   int result = resolver(var, address);
   if (result != 0) {
-    ur_add(var, address, resolver);
+    ur_add_i(var, address, resolver, name, true);
   }
   return result;
 }
 
-void ur_add(variant data, void *ptrptr, resolve_fun fun)
+void ur_add_i(variant data, void *ptrptr, resolve_fun fun, const char *name,
+  bool intkey)
 {
   if (ur_list == NULL) {
     ur_list = malloc(BLOCKSIZE * sizeof(unresolved));
@@ -69,15 +76,59 @@ void ur_add(variant data, void *ptrptr, resolve_fun fun)
   ur_current->data = data;
   ur_current->resolve = fun;
   ur_current->ptrptr = ptrptr;
+  ur_current->name = (name[0] == '&') ? name + 1 : name;
+  ur_current->intkey = intkey;
 
   ++ur_current;
   ur_current->resolve = NULL;
   ur_current->data.v = NULL;
 }
 
-void resolve(void)
+/* references are resolved in groups, one group per resolve function, in
+ * the order in which each function was first used. some resolvers rely
+ * on another type being done before them (walls before their buddies).
+ * inside a group, entries with an integer key are sorted by it, so
+ * lookups walk the hashes in order.
+ */
+#define MAXGROUPS 64
+
+typedef struct ur_entry {
+  unresolved ur;
+  int group;
+  int key;
+  int seq;
+} ur_entry;
+
+static int cmp_entry(const void *a, const void *b)
+{
+  const ur_entry *ea = (const ur_entry *)a;
+  const ur_entry *eb = (const ur_entry *)b;
+  if (ea->group != eb->group) {
+    return ea->group - eb->group;
+  }
+  if (ea->key != eb->key) {
+    return (ea->key < eb->key) ? -1 : 1;
+  }
+  return ea->seq - eb->seq;
+}
+
+static void resolve_i(bool keep)
 {
-  unresolved *ur = ur_list;
+  resolve_fun groups[MAXGROUPS];
+  int ngroups = 0, n = 0, i;
+  ur_entry *entries;
+  unresolved *ur;
+
+  for (ur = ur_list; ur; ++ur) {
+    if (ur->resolve == NULL) {
+      ur = ur->data.v;
+      if (!ur) break;
+    }
+    ++n;
+  }
+  entries = (ur_entry *)malloc(sizeof(ur_entry) * (n + 1));
+  n = 0;
+  ur = ur_list;
   while (ur) {
     if (ur->resolve == NULL) {
       ur = ur->data.v;
@@ -85,9 +136,47 @@ void resolve(void)
       ur_list = ur;
       continue;
     }
-    ur->resolve(ur->data, ur->ptrptr);
+    for (i = ngroups - 1; i >= 0 && groups[i] != ur->resolve; --i);
+    if (i < 0) {
+      assert(ngroups < MAXGROUPS);
+      i = ngroups++;
+      groups[i] = ur->resolve;
+    }
+    entries[n].ur = *ur;
+    entries[n].group = i;
+    entries[n].key = ur->intkey ? ur->data.i : 0;
+    entries[n].seq = n;
+    ++n;
     ++ur;
   }
   free(ur_list);
   ur_list = NULL;
+
+  qsort(entries, n, sizeof(ur_entry), cmp_entry);
+  for (i = 0; i != n;) {
+    int g = entries[i].group, first = i;
+    clock_t start = clock();
+    for (; i != n && entries[i].group == g; ++i) {
+      unresolved *entry = &entries[i].ur;
+      if (entry->resolve(entry->data, entry->ptrptr) != 0 && keep) {
+        ur_add_i(entry->data, entry->ptrptr, entry->resolve, entry->name,
+          entry->intkey);
+      }
+    }
+    log_debug("resolve: %d references for %s in %.3fs", i - first,
+      entries[first].ur.name, (double)(clock() - start) / CLOCKS_PER_SEC);
+  }
+  free(entries);
+}
+
+void resolve(void)
+{
+  resolve_i(false);
+}
+
+/* references that cannot be resolved yet are kept, and tried again by
+ * the next call to resolve_pending() or resolve(). */
+void resolve_pending(void)
+{
+  resolve_i(true);
 }
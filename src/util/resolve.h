@@ -28,11 +28,22 @@ extern "C" {
 
   typedef int (*resolve_fun) (variant data, void *address);
   typedef variant(*read_fun) (struct storage * store);
-  extern int read_reference(void *address, struct storage *store,
-    read_fun reader, resolve_fun resolver);
+  extern int read_reference_i(void *address, struct storage *store,
+    read_fun reader, resolve_fun resolver, const char *name);
+  extern void ur_add_i(variant data, void *address, resolve_fun fun,
+    const char *name, bool intkey);
+
+/* the macros pass the name of the resolve function along, so resolve()
+ * can report the cost of each one. ur_add and read_reference expect an
+ * integer id in data.i, and resolve those in key order. ur_add_ptr is
+ * for any other data, which is resolved in the order it was added. */
+#define read_reference(address, store, reader, resolver) \
+  read_reference_i(address, store, reader, resolver, #resolver)
+#define ur_add(data, address, fun) ur_add_i(data, address, fun, #fun, true)
+#define ur_add_ptr(data, address, fun) ur_add_i(data, address, fun, #fun, false)
 
-  extern void ur_add(variant data, void *address, resolve_fun fun);
   extern void resolve(void);
+  extern void resolve_pending(void);
 
   extern variant read_int(struct storage *store);
 
@@ -0,0 +1,140 @@
+#include <platform.h>
+#include <CuTest.h>
+#include "resolve.h"
+
+static int order[8];
+static int norder;
+
+static int resolve_a(variant data, void *address)
+{
+  order[norder++] = data.i;
+  *(int *)address = data.i;
+  return 0;
+}
+
+static int resolve_b(variant data, void *address)
+{
+  order[norder++] = -data.i;
+  *(int *)address = -data.i;
+  return 0;
+}
+
+static void test_resolve(CuTest * tc)
+{
+  int x[5];
+  variant var;
+
+  norder = 0;
+  var.i = 3;
+  ur_add(var, x + 0, resolve_a);
+  var.i = 2;
+  ur_add(var, x + 1, resolve_b);
+  var.i = 1;
+  ur_add(var, x + 2, resolve_a);
+  var.i = 1;
+  ur_add(var, x + 3, resolve_b);
+  var.i = 2;
+  ur_add(var, x + 4, resolve_a);
+  resolve();
+
+  CuAssertIntEquals(tc, 5, norder);
+  CuAssertIntEquals(tc, 3, x[0]);
+  CuAssertIntEquals(tc, -2, x[1]);
+  CuAssertIntEquals(tc, 1, x[2]);
+  CuAssertIntEquals(tc, -1, x[3]);
+  CuAssertIntEquals(tc, 2, x[4]);
+  /* grouped by resolver in order of first use, sorted by key */
+  CuAssertIntEquals(tc, 1, order[0]);
+  CuAssertIntEquals(tc, 2, order[1]);
+  CuAssertIntEquals(tc, 3, order[2]);
+  CuAssertIntEquals(tc, -1, order[3]);
+  CuAssertIntEquals(tc, -2, order[4]);
+
+  norder = 0;
+  resolve();
+  CuAssertIntEquals(tc, 0, norder);
+}
+
+static int resolve_p(variant data, void *address)
+{
+  int *target = (int *)data.v;
+  order[norder++] = *target;
+  *(int **)address = target;
+  return 0;
+}
+
+static void test_resolve_ptr(CuTest * tc)
+{
+  int values[3] = { 1, 2, 3 };
+  int *x[3];
+  variant var;
+
+  norder = 0;
+  var.v = values + 2;
+  ur_add_ptr(var, x + 0, resolve_p);
+  var.v = values + 0;
+  ur_add_ptr(var, x + 1, resolve_p);
+  var.v = values + 1;
+  ur_add_ptr(var, x + 2, resolve_p);
+  resolve();
+
+  /* pointers are not keys, these keep the order they were added in */
+  CuAssertIntEquals(tc, 3, norder);
+  CuAssertIntEquals(tc, 3, order[0]);
+  CuAssertIntEquals(tc, 1, order[1]);
+  CuAssertIntEquals(tc, 2, order[2]);
+  CuAssertPtrEquals(tc, values + 2, x[0]);
+  CuAssertPtrEquals(tc, values + 0, x[1]);
+  CuAssertPtrEquals(tc, values + 1, x[2]);
+}
+
+static int fail_p;
+
+static int resolve_q(variant data, void *address)
+{
+  resolve_p(data, address);
+  return fail_p;
+}
+
+static void test_resolve_pending_ptr(CuTest * tc)
+{
+  int values[3] = { 1, 2, 3 };
+  int *x[3];
+  variant var;
+  int i;
+
+  var.v = values + 2;
+  ur_add_ptr(var, x + 0, resolve_q);
+  var.v = values + 0;
+  ur_add_ptr(var, x + 1, resolve_q);
+  var.v = values + 1;
+  ur_add_ptr(var, x + 2, resolve_q);
+
+  /* entries that are put back keep their insertion order */
+  fail_p = 1;
+  for (i = 0; i != 2; ++i) {
+    norder = 0;
+    resolve_pending();
+    CuAssertIntEquals(tc, 3, norder);
+    CuAssertIntEquals(tc, 3, order[0]);
+    CuAssertIntEquals(tc, 1, order[1]);
+    CuAssertIntEquals(tc, 2, order[2]);
+  }
+  fail_p = 0;
+  norder = 0;
+  resolve_pending();
+  CuAssertIntEquals(tc, 3, norder);
+  CuAssertIntEquals(tc, 3, order[0]);
+  norder = 0;
+  resolve();
+  CuAssertIntEquals(tc, 0, norder);
+}
+
+CuSuite *get_resolve_suite(void)
+{
+  CuSuite *suite = CuSuiteNew();
+  SUITE_ADD_TEST(suite, test_resolve);
+  SUITE_ADD_TEST(suite, test_resolve_ptr);
+  SUITE_ADD_TEST(suite, test_resolve_pending_ptr);
+  return suite;
+}
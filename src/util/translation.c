@@ -106,46 +106,7 @@ void brelease(void)
 }
 
 /**
- ** constant values
- **/
-
-typedef struct variable {
-  struct variable *next;
-  const char *symbol;
-  variant value;
-} variable;
-
-static variable *variables;
-
-static void free_variables(void)
-{
-  variables = NULL;
-}
-
-static void add_variable(const char *symbol, variant value)
-{
-  variable *var = (variable *) balloc(sizeof(variable));
-
-  var->value = value;
-  var->symbol = symbol;
-
-  var->next = variables;
-  variables = var;
-}
-
-static variable *find_variable(const char *symbol)
-{
-  variable *var = variables;
-  while (var) {
-    if (!strcmp(var->symbol, symbol))
-      break;
-    var = var->next;
-  }
-  return var;
-}
-
-/**
- ** constant values
+ ** functions
  **/
 
 static struct critbit_tree functions = { 0 };
@@ -177,13 +138,117 @@ static evalfun find_function(const char *symbol)
   return 0;
 }
 
-static const char *parse(opstack **, const char *in, const void *);
-/* static const char * sample = "\"enno and $bool($if($eq($i,0),\"noone else\",\"$i other people\"))\""; */
+/**
+ ** compiled templates
+ **
+ ** a template is parsed once into a list of operations for a small stack
+ ** machine. strings become BEGIN ... END pairs, with the literal parts as
+ ** TEXT, and symbols inside a string followed by an APPEND. arguments are
+ ** resolved to their index in the message, and functions are looked up
+ ** the first time they are called.
+ **/
+
+enum {
+  OP_BEGIN,                     /* start a new string */
+  OP_TEXT,                      /* append literal text to the string */
+  OP_APPEND,                    /* pop a string, append it to the string */
+  OP_END,                       /* finish the string and push it */
+  OP_ARG,                       /* push an argument of the message */
+  OP_INT,                       /* push an integer constant */
+  OP_CALL                       /* call a function */
+};
+
+typedef struct op {
+  int code;
+  int i;                        /* index, constant, or offset into text */
+  int len;                      /* length of a TEXT */
+  evalfun fun;                  /* resolved function for a CALL */
+} op;
+
+struct translation {
+  op *ops;
+  int nops, maxops;
+  char *text;                   /* literals and function names */
+  int ntext, maxtext;
+  int depth, maxdepth;          /* nesting of strings */
+};
+
+#define MAXNESTING 16
+#define TOKENSIZE 4096
+
+static op *add_op(translation * t, int code, int i)
+{
+  op *o;
+  if (t->nops == t->maxops) {
+    t->maxops = t->maxops ? t->maxops * 2 : 8;
+    t->ops = realloc(t->ops, sizeof(op) * t->maxops);
+  }
+  o = t->ops + t->nops++;
+  o->code = code;
+  o->i = i;
+  o->len = 0;
+  o->fun = NULL;
+  return o;
+}
 
-static const char *parse_symbol(opstack ** stack, const char *in,
-  const void *userdata)
+static int add_text(translation * t, const char *str, int len)
+{
+  int pos = t->ntext;
+  if (t->ntext + len + 1 > t->maxtext) {
+    while (t->ntext + len + 1 > t->maxtext) {
+      t->maxtext = t->maxtext ? t->maxtext * 2 : 64;
+    }
+    t->text = realloc(t->text, t->maxtext);
+  }
+  memcpy(t->text + pos, str, len);
+  t->text[pos + len] = '\0';
+  t->ntext += len + 1;
+  return pos;
+}
+
+/* adds a literal character, merging it into a preceding TEXT */
+static void add_char(translation * t, char c)
+{
+  op *o = t->nops ? t->ops + t->nops - 1 : NULL;
+  if (o && o->code == OP_TEXT) {
+    /* the last TEXT is always at the end of the text buffer */
+    add_text(t, "", 0);
+    t->text[o->i + o->len++] = c;
+    t->text[o->i + o->len] = '\0';
+  }
+  else {
+    o = add_op(t, OP_TEXT, add_text(t, &c, 1));
+    o->len = 1;
+  }
+}
+
+/* returns the position of the argument in the list of variable names.
+ * if a name occurs more than once, the last one wins. */
+static int find_arg(const char *vars, const char *symbol)
+{
+  const char *ic = vars;
+  int i = 0, result = -1;
+  size_t len = strlen(symbol);
+  while (*ic) {
+    const char *name = ic;
+    while (isalnum(*ic))
+      ++ic;
+    if ((size_t)(ic - name) == len && strncmp(name, symbol, len) == 0) {
+      result = i;
+    }
+    ++i;
+    while (*ic && !isalnum(*ic))
+      ++ic;
+  }
+  return result;
+}
+
+static const char *compile(translation *, const char *in, const char *vars);
+
+static const char *compile_symbol(translation * t, const char *in,
+  const char *vars)
 /* in is the symbol name and following text, starting after the $ 
- * result goes on the stack
+ * the code for it pushes the result on the stack
  */
 {
   bool braces = false;
@@ -194,82 +259,69 @@ static const char *parse_symbol(opstack ** stack, const char *in,
     braces = true;
     ++in;
   }
-  while (isalnum(*in) || *in == '.')
-    *cp++ = *in++;
+  while (isalnum(*in) || *in == '.') {
+    if (cp != symbol + sizeof(symbol) - 1)
+      *cp++ = *in;
+    ++in;
+  }
   *cp = '\0';
   /* symbol will now contain the symbol name */
   if (*in == '(') {
-    /* it's a function we need to parse, start by reading the parameters */
-    evalfun foo;
-
+    /* it's a function, start by compiling the parameters */
+    op *o;
     while (*in != ')') {
-      in = parse(stack, ++in, userdata);        /* will push the result on the stack */
+      in = compile(t, ++in, vars);      /* will push the result on the stack */
       if (in == NULL)
         return NULL;
     }
     ++in;
-    foo = find_function(symbol);
-    if (foo == NULL) {
-      log_error("parser does not know about \"%s\" function.\n", symbol);
-      return NULL;
-    }
-    foo(stack, userdata);        /* will pop parameters from stack (reverse order!) and push the result */
+    o = add_op(t, OP_CALL, add_text(t, symbol, (int)strlen(symbol)));
+    o->fun = find_function(symbol);
   } else {
-    variable *var = find_variable(symbol);
+    int i = find_arg(vars, symbol);
     if (braces && *in == '}') {
       ++in;
     }
-    /* it's a constant (variable is a misnomer, but heck, const was taken;)) */
-    if (var == NULL) {
+    if (i < 0) {
       log_error("parser does not know about \"%s\" variable.\n", symbol);
       return NULL;
     }
-    opush(stack, var->value);
+    add_op(t, OP_ARG, i);
   }
   return in;
 }
 
-#define TOKENSIZE 4096
-static const char *parse_string(opstack ** stack, const char *in,
-  const void *userdata)
+static const char *compile_string(translation * t, const char *in,
+  const char *vars)
 {                               /* (char*) -> char* */
-  char *c;
-  char *buffer = balloc(TOKENSIZE);
-  size_t size = TOKENSIZE - 1;
   const char *ic = in;
-  char *oc = buffer;
   /* mode flags */
   bool f_escape = false;
   bool bDone = false;
-  variant var;
 
+  if (++t->depth > MAXNESTING) {
+    log_error("strings are nested too deep in \"%s\".", in);
+    return NULL;
+  }
+  if (t->depth > t->maxdepth) {
+    t->maxdepth = t->depth;
+  }
+  add_op(t, OP_BEGIN, 0);
   while (*ic && !bDone) {
     if (f_escape) {
       f_escape = false;
       switch (*ic) {
         case 'n':
-          if (size > 0) {
-            *oc++ = '\n';
-            --size;
-          }
+          add_char(t, '\n');
           break;
         case 't':
-          if (size > 0) {
-            *oc++ = '\t';
-            --size;
-          }
+          add_char(t, '\t');
           break;
         default:
-          if (size > 0) {
-            *oc++ = *ic++;
-            --size;
-          }
+          add_char(t, *ic++);
       }
     } else {
-      int ch = (unsigned char)(*ic);
-      int bytes;
-
-      switch (ch) {
+      switch (*ic) {
         case '\\':
           f_escape = true;
           ++ic;
@@ -279,39 +331,26 @@ static const char *parse_string(opstack ** stack, const char *in,
           ++ic;
           break;
         case '$':
-          ic = parse_symbol(stack, ++ic, userdata);
+          ic = compile_symbol(t, ++ic, vars);
           if (ic == NULL)
             return NULL;
-          c = (char *)opop_v(stack);
-          bytes = (int)(c?strlcpy(oc, c, size):0);
-          if (bytes < (int)size)
-            oc += bytes;
-          else
-            oc += size;
-          bfree(c);
+          add_op(t, OP_APPEND, 0);
           break;
         default:
-          if (size > 0) {
-            *oc++ = *ic++;
-            --size;
-          } else
-            ++ic;
+          add_char(t, *ic++);
       }
     }
   }
-  *oc++ = '\0';
-  bfree(oc);
-  var.v = buffer;
-  opush(stack, var);
+  add_op(t, OP_END, 0);
+  --t->depth;
   return ic;
 }
 
-static const char *parse_int(opstack ** stack, const char *in)
+static const char *compile_int(translation * t, const char *in)
 {
   int k = 0;
   int vz = 1;
   bool ok = false;
-  variant var;
   do {
     switch (*in) {
       case '+':
@@ -328,26 +367,25 @@ static const char *parse_int(opstack ** stack, const char *in)
   while (isdigit(*(unsigned char *)in)) {
     k = k * 10 + (*in++) - '0';
   }
-  var.i = k * vz;
-  opush(stack, var);
+  add_op(t, OP_INT, k * vz);
   return in;
 }
 
-static const char *parse(opstack ** stack, const char *inn,
-  const void *userdata)
+static const char *compile(translation * t, const char *inn,
+  const char *vars)
 {
   const char *b = inn;
   while (*b) {
     switch (*b) {
       case '"':
-        return parse_string(stack, ++b, userdata);
+        return compile_string(t, ++b, vars);
         break;
       case '$':
-        return parse_symbol(stack, ++b, userdata);
+        return compile_symbol(t, ++b, vars);
         break;
       default:
         if (isdigit(*(unsigned char *)b) || *b == '-' || *b == '+') {
-          return parse_int(stack, b);
+          return compile_int(t, b);
         } else
           ++b;
     }
@@ -356,45 +394,143 @@ static const char *parse(opstack ** stack, const char *inn,
   return NULL;
 }
 
-const char *translate(const char *format, const void *userdata,
-  const char *vars, variant args[])
+void translation_free(translation * t)
 {
-  int i = 0;
-  const char *ic = vars;
-  char symbol[32];
-  char *oc = symbol;
-  opstack *stack = NULL;
-  const char *rv;
+  if (t) {
+    free(t->ops);
+    free(t->text);
+    free(t);
+  }
+}
 
-  brelease();
-  free_variables();
+translation *translation_compile(const char *format, const char *vars)
+{
+  translation *t = calloc(1, sizeof(translation));
+  const char *rv;
 
   assert(format);
-  assert(*ic == 0 || isalnum(*ic));
-  while (*ic) {
-    *oc++ = *ic++;
-    if (!isalnum(*ic)) {
-      variant x = args[i++];
-      *oc = '\0';
-      oc = symbol;
-      add_variable(strcpy(balloc(strlen(symbol) + 1), symbol), x);
-      while (*ic && !isalnum(*ic))
-        ++ic;
-    }
-  }
-
+  assert(*vars == 0 || isalnum(*vars));
   if (format[0] == '"') {
-    rv = parse(&stack, format, userdata);
+    rv = compile(t, format, vars);
   } else {
-    rv = parse_string(&stack, format, userdata);
+    rv = compile_string(t, format, vars);
+  }
+  if (rv == NULL) {
+    translation_free(t);
+    return NULL;
+  }
+  if (rv[0]) {
+    log_error("residual data after parsing: %s\n", rv);
+  }
+  /* the outermost string is rendered into the caller's buffer */
+  assert(t->ops[0].code == OP_BEGIN && t->ops[t->nops - 1].code == OP_END);
+  return t;
+}
+
+typedef struct frame {
+  char *begin;
+  char *oc;
+  size_t size;                  /* space left, not counting the terminator */
+  size_t len;                   /* length of the complete string */
+} frame;
+
+static void frame_append(frame * fr, const char *str, size_t len)
+{
+  size_t bytes = (len < fr->size) ? len : fr->size;
+  memcpy(fr->oc, str, bytes);
+  fr->oc += bytes;
+  fr->size -= bytes;
+  fr->len += len;
+}
+
+static opstack *free_stack;
+
+const char *translation_render(translation * t, const void *userdata,
+  variant args[], char *buffer, size_t size, size_t *length)
+{
+  frame frames[MAXNESTING];
+  int depth = -1, i;
+  opstack *stack = free_stack;
+  const char *rv = buffer;
+
+  free_stack = NULL;            /* in case a function renders, too */
+  brelease();
+  for (i = 0; i != t->nops && rv; ++i) {
+    op *o = t->ops + i;
+    frame *fr;
+    char *c;
+
+    switch (o->code) {
+      case OP_BEGIN:
+        fr = frames + ++depth;
+        if (depth == 0) {
+          fr->begin = buffer;
+          fr->size = size ? size - 1 : 0;
+        } else {
+          fr->begin = balloc(TOKENSIZE);
+          fr->size = TOKENSIZE - 1;
+          if (fr->begin == NULL) {
+            log_error("out of memory rendering \"%s\".", t->text);
+            rv = NULL;
+          }
+        }
+        fr->oc = fr->begin;
+        fr->len = 0;
+        break;
+      case OP_TEXT:
+        frame_append(frames + depth, t->text + o->i, o->len);
+        break;
+      case OP_APPEND:
+        c = (char *)opop_v(&stack);
+        if (c) {
+          frame_append(frames + depth, c, strlen(c));
+        }
+        bfree(c);
+        break;
+      case OP_END:
+        fr = frames + depth--;
+        if (depth >= 0) {
+          variant var;
+          *fr->oc++ = '\0';
+          bfree(fr->oc);
+          var.v = fr->begin;
+          opush(&stack, var);
+        } else {
+          if (size > 0) {
+            *fr->oc = '\0';
+          }
+          if (length) {
+            *length = fr->len;
+          }
+        }
+        break;
+      case OP_ARG:
+        opush(&stack, args[o->i]);
+        break;
+      case OP_INT:
+        opush_i(&stack, o->i);
+        break;
+      case OP_CALL:
+        if (o->fun == NULL) {
+          o->fun = find_function(t->text + o->i);
+          if (o->fun == NULL) {
+            log_error("parser does not know about \"%s\" function.\n", t->text + o->i);
+            rv = NULL;
+            break;
+          }
+        }
+        o->fun(&stack, userdata);  /* will pop parameters from stack (reverse order!) and push the result */
+        break;
+    }
   }
-  if (rv != NULL) {
-    if (rv[0]) {
-      log_error("residual data after parsing: %s\n", rv);
+  if (stack) {
+    stack->top = stack->begin;
+    if (free_stack) {
+      free(stack->begin);
+      free(stack);
+    } else {
+      free_stack = stack;
     }
-    rv = (const char *)opop(&stack).v;
-    free(stack->begin);
-    free(stack);
   }
   return rv;
 }
@@ -475,4 +611,9 @@ void translation_done(void)
 {
   free_functions();
   free(buffer.begin);
+  if (free_stack) {
+    free(free_stack->begin);
+    free(free_stack);
+    free_stack = NULL;
+  }
 }
@@ -30,8 +30,15 @@ extern "C" {
 
   extern void translation_init(void);
   extern void translation_done(void);
-  extern const char *translate(const char *format, const void *userdata,
-    const char *vars, variant args[]);
+
+/* compiled message templates */
+  typedef struct translation translation;
+  extern translation *translation_compile(const char *format,
+    const char *vars);
+  extern const char *translation_render(translation * t,
+    const void *userdata, variant args[], char *buffer, size_t size,
+    size_t *length);
+  extern void translation_free(translation * t);
 
 /* eval_x functions */
   typedef void (*evalfun) (struct opstack ** stack, const void *);
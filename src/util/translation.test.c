@@ -0,0 +1,74 @@
+#include <platform.h>
+#include "translation.h"
+
+#include <CuTest.h>
+#include <string.h>
+
+static const char *render(translation *t, variant args[], size_t *len)
+{
+    static char buffer[64];
+    return translation_render(t, NULL, args, buffer, sizeof(buffer), len);
+}
+
+static void test_translation_text(CuTest * tc)
+{
+    translation *t;
+    variant args[2];
+    size_t len;
+
+    translation_init();
+    args[0].v = "Enno";
+    args[1].i = 3;
+    t = translation_compile("\"Hello $name and ${name}s.\"", "name count");
+    CuAssertPtrNotNull(tc, t);
+    CuAssertStrEquals(tc, "Hello Enno and Ennos.", render(t, args, &len));
+    CuAssertIntEquals(tc, 21, (int)len);
+    translation_free(t);
+
+    t = translation_compile("$int($add($count,1)) items", "name count");
+    CuAssertPtrNotNull(tc, t);
+    CuAssertStrEquals(tc, "4 items", render(t, args, &len));
+    translation_free(t);
+
+    CuAssertPtrEquals(tc, NULL, translation_compile("\"$unknown\"", "name count"));
+}
+
+static void test_translation_nested(CuTest * tc)
+{
+    translation *t;
+    variant args[1];
+    size_t len;
+
+    translation_init();
+    t = translation_compile("\"$if($eq($i,0),\"noone else\",\"$int($i) other people\")\"", "i");
+    CuAssertPtrNotNull(tc, t);
+    args[0].i = 0;
+    CuAssertStrEquals(tc, "noone else", render(t, args, &len));
+    args[0].i = 2;
+    CuAssertStrEquals(tc, "2 other people", render(t, args, &len));
+    translation_free(t);
+}
+
+static void test_translation_truncate(CuTest * tc)
+{
+    translation *t;
+    char buffer[8];
+    size_t len;
+
+    translation_init();
+    t = translation_compile("\"a long piece of text\"", "");
+    CuAssertPtrNotNull(tc, t);
+    CuAssertPtrEquals(tc, buffer, (void *)translation_render(t, NULL, NULL, buffer, sizeof(buffer), &len));
+    CuAssertStrEquals(tc, "a long ", buffer);
+    CuAssertIntEquals(tc, 20, (int)len);
+    translation_free(t);
+}
+
+CuSuite *get_translation_suite(void)
+{
+    CuSuite *suite = CuSuiteNew();
+    SUITE_ADD_TEST(suite, test_translation_text);
+    SUITE_ADD_TEST(suite, test_translation_nested);
+    SUITE_ADD_TEST(suite, test_translation_truncate);
+    return suite;
+}